@@ -0,0 +1,362 @@
+/*
+ * Search benchmarks, run with `meson test --benchmark -v`.
+ *
+ * Items come from a synthetic catalog built from a fixed seed, so runs
+ * are comparable with each other. Times are per query, averaged over
+ * REPEATS runs; build with --buildtype=release for meaningful numbers.
+ */
+
+#include "app_item.h"
+#include "search.h"
+#include <string.h>
+
+#define SEED 0x6879706d
+#define REPEATS 200
+
+/* Ranking has to stay under 1 ms for this many apps */
+#define RANK_ITEMS 5000
+#define RANK_LIMIT 50
+#define RANK_BUDGET_US 1000.0
+
+/* The matcher's prefilter kernels, compared on keys of these lengths */
+#define KERNEL_KEYS 1000
+static const guint kernel_key_lengths[] = { 16, 64, 256 };
+static const struct {
+  HyprMenuSearchKernel kernel;
+  const char *name;
+} kernels[] = {
+  { HYPRMENU_SEARCH_KERNEL_SCALAR, "scalar" },
+  { HYPRMENU_SEARCH_KERNEL_SSE2, "sse2" },
+  { HYPRMENU_SEARCH_KERNEL_AVX2, "avx2" },
+};
+
+/* Substring filtering, cached folded keys against lowercasing per keystroke */
+#define FILTER_ITEMS 10000
+
+static const char *words[] = {
+  "Firefox", "Code", "Terminal", "Files", "Settings", "Office", "Writer",
+  "Calc", "Image", "Viewer", "Music", "Player", "Video", "Editor", "Text",
+  "Mail", "Chat", "Browser", "Manager", "Disk", "System", "Monitor",
+  "Network", "Calendar", "Camera", "Scanner", "Barcode", "Studio", "Notes",
+  "Photo", "Archive", "Clock", "Weather", "Maps", "Font", "Color", "Café",
+  "Éditeur", "Lecteur", "Größe", "Sound", "Recorder", "Backup", "Password",
+};
+
+static const char *queries[] = {
+  "f", "ffx", "code", "term", "vsc", "set", "image viewer", "zzz",
+};
+
+static const char *
+pick_word (GRand *rand)
+{
+  return words[g_rand_int_range (rand, 0, G_N_ELEMENTS (words))];
+}
+
+/**
+ * Build a synthetic catalog
+ * @param n_items Number of apps
+ * @return A new array of HyprMenuAppItem
+ */
+static GPtrArray *
+make_items (guint n_items)
+{
+  GRand *rand = g_rand_new_with_seed (SEED);
+  GPtrArray *items = g_ptr_array_new_full (n_items, g_object_unref);
+
+  for (guint i = 0; i < n_items; i++) {
+    const char *first = pick_word (rand);
+    const char *second = pick_word (rand);
+    const char *third = pick_word (rand);
+    char *id = g_strdup_printf ("org.example.App%u.desktop", i);
+    char *filename = g_strdup_printf ("/usr/share/applications/%s", id);
+    char *name = g_strdup_printf ("%s %s", first, second);
+    char *generic_name = g_strdup_printf ("%s %s", second, third);
+    char *comment = g_strdup_printf ("%s your %s with %s", first, second, third);
+    char *keywords = g_strdup_printf ("%s;%s;", third, first);
+    char *exec = g_strdup_printf ("/usr/bin/%s-%s %%U", first, third);
+    HyprMenuCatalogEntry entry = {
+      .id = id,
+      .filename = filename,
+      .name = name,
+      .generic_name = generic_name,
+      .comment = comment,
+      .keywords = keywords,
+      .categories = "Utility;",
+      .exec = exec,
+    };
+
+    g_ptr_array_add (items, hyprmenu_app_item_new (&entry));
+
+    g_free (exec);
+    g_free (keywords);
+    g_free (comment);
+    g_free (generic_name);
+    g_free (name);
+    g_free (filename);
+    g_free (id);
+  }
+
+  g_rand_free (rand);
+  return items;
+}
+
+typedef guint (*BenchFunc) (gpointer data);
+
+/**
+ * Time a function
+ * @param func Runs once and returns the number of matches
+ * @param data Data for func
+ * @param n_matches Return location for the number of matches
+ * @param best Return location for the quickest run in microseconds
+ * @return The mean run time in microseconds
+ */
+static double
+measure (BenchFunc func, gpointer data, guint *n_matches, double *best)
+{
+  gint64 total = 0;
+  gint64 quickest = G_MAXINT64;
+
+  /* Warm the caches first */
+  *n_matches = func (data);
+
+  for (guint i = 0; i < REPEATS; i++) {
+    gint64 start = g_get_monotonic_time ();
+    func (data);
+    gint64 elapsed = g_get_monotonic_time () - start;
+
+    total += elapsed;
+    quickest = MIN (quickest, elapsed);
+  }
+
+  *best = quickest;
+  return (double)total / REPEATS;
+}
+
+typedef struct {
+  GPtrArray *items;
+  const char *query;    /* As typed */
+} BenchQuery;
+
+/* What the menu does per keystroke: fold the query, score every app,
+ * keep the best */
+static guint
+run_rank (gpointer data)
+{
+  BenchQuery *bench = data;
+  char *folded = hyprmenu_search_fold (bench->query);
+  GArray *results = hyprmenu_search_rank (bench->items, folded);
+  GArray *top = hyprmenu_search_top (results, RANK_LIMIT);
+  guint n_matches = results->len;
+
+  g_array_unref (top);
+  g_array_unref (results);
+  g_free (folded);
+  return n_matches;
+}
+
+static gboolean
+bench_rank (void)
+{
+  GPtrArray *items = make_items (RANK_ITEMS);
+  gboolean within_budget = TRUE;
+
+  g_print ("Ranking %u apps, top %u (budget %.0f us)\n", items->len, RANK_LIMIT, RANK_BUDGET_US);
+
+  for (guint i = 0; i < G_N_ELEMENTS (queries); i++) {
+    BenchQuery bench = { items, queries[i] };
+    guint n_matches;
+    double best;
+    double mean = measure (run_rank, &bench, &n_matches, &best);
+
+    g_print ("  %-14s %5u matches  mean %8.1f us  best %8.1f us%s\n",
+             queries[i], n_matches, mean, best,
+             mean > RANK_BUDGET_US ? "  OVER BUDGET" : "");
+    within_budget &= mean <= RANK_BUDGET_US;
+  }
+
+  g_ptr_array_unref (items);
+  return within_budget;
+}
+
+typedef struct {
+  GPtrArray *keys;
+  const char *query;    /* Folded */
+} BenchKeys;
+
+/* Match one query against every key, as ranking does per field */
+static guint
+run_match (gpointer data)
+{
+  BenchKeys *bench = data;
+  gsize query_len = strlen (bench->query);
+  guint n_matches = 0;
+
+  for (guint i = 0; i < bench->keys->len; i++) {
+    HyprMenuSearchMatch match;
+
+    if (hyprmenu_search_match (bench->query, query_len,
+                               g_ptr_array_index (bench->keys, i), NULL, &match)) {
+      n_matches++;
+    }
+  }
+  return n_matches;
+}
+
+/**
+ * Build folded keys of a fixed length out of the word list
+ * @param length Length of every key in bytes
+ * @return A new array of strings
+ */
+static GPtrArray *
+make_keys (guint length)
+{
+  GRand *rand = g_rand_new_with_seed (SEED);
+  GPtrArray *keys = g_ptr_array_new_full (KERNEL_KEYS, g_free);
+
+  for (guint i = 0; i < KERNEL_KEYS; i++) {
+    GString *key = g_string_sized_new (length + 16);
+
+    while (key->len < length) {
+      char *word = hyprmenu_search_fold (pick_word (rand));
+      g_string_append (key, word);
+      g_string_append_c (key, ' ');
+      g_free (word);
+    }
+    g_string_truncate (key, length);
+    g_ptr_array_add (keys, g_string_free (key, FALSE));
+  }
+
+  g_rand_free (rand);
+  return keys;
+}
+
+static void
+bench_kernels (void)
+{
+  HyprMenuSearchKernel best = hyprmenu_search_get_kernel ();
+
+  for (guint l = 0; l < G_N_ELEMENTS (kernel_key_lengths); l++) {
+    GPtrArray *keys = make_keys (kernel_key_lengths[l]);
+
+    g_print ("Matching %u keys of %u bytes by prefilter kernel (best us)\n",
+             keys->len, kernel_key_lengths[l]);
+    g_print ("  %-14s", "");
+    for (guint k = 0; k < G_N_ELEMENTS (kernels); k++) {
+      g_print (" %9s", kernels[k].name);
+    }
+    g_print ("\n");
+
+    for (guint i = 0; i < G_N_ELEMENTS (queries); i++) {
+      char *folded = hyprmenu_search_fold (queries[i]);
+      BenchKeys bench = { keys, folded };
+
+      g_print ("  %-14s", queries[i]);
+      for (guint k = 0; k < G_N_ELEMENTS (kernels); k++) {
+        guint n_matches;
+        double best_run;
+
+        if (!hyprmenu_search_set_kernel (kernels[k].kernel)) {
+          g_print (" %9s", "-");
+          continue;
+        }
+        measure (run_match, &bench, &n_matches, &best_run);
+        g_print (" %9.1f", best_run);
+      }
+      g_print ("\n");
+      g_free (folded);
+    }
+
+    g_ptr_array_unref (keys);
+  }
+
+  hyprmenu_search_set_kernel (best);
+}
+
+/* The filter before folded keys: lowercase the query and, for every app,
+ * its name and description, then strstr() them. Three allocations per
+ * app per keystroke. */
+static guint
+run_filter_strdown (gpointer data)
+{
+  BenchQuery *bench = data;
+  char *query = g_utf8_strdown (bench->query, -1);
+  guint n_matches = 0;
+
+  for (guint i = 0; i < bench->items->len; i++) {
+    HyprMenuAppItem *item = g_ptr_array_index (bench->items, i);
+    char *name = g_utf8_strdown (hyprmenu_app_item_get_name (item), -1);
+    char *description = g_utf8_strdown (hyprmenu_app_item_get_description (item), -1);
+
+    if (strstr (name, query) || strstr (description, query)) {
+      n_matches++;
+    }
+
+    g_free (description);
+    g_free (name);
+  }
+
+  g_free (query);
+  return n_matches;
+}
+
+/* The same substring filter over the keys folded at load time: one fold
+ * per keystroke, then nothing but mask tests and byte searches */
+static guint
+run_filter_folded (gpointer data)
+{
+  BenchQuery *bench = data;
+  char *query = hyprmenu_search_fold (bench->query);
+  guint64 query_mask = hyprmenu_search_mask (query);
+  guint n_matches = 0;
+
+  for (guint i = 0; i < bench->items->len; i++) {
+    HyprMenuAppItem *item = g_ptr_array_index (bench->items, i);
+    const char *generic_name_key = hyprmenu_app_item_get_generic_name_key (item);
+
+    if (query_mask & ~hyprmenu_app_item_get_search_mask (item)) {
+      continue;
+    }
+    if (strstr (hyprmenu_app_item_get_name_key (item), query) ||
+        (generic_name_key && strstr (generic_name_key, query))) {
+      n_matches++;
+    }
+  }
+
+  g_free (query);
+  return n_matches;
+}
+
+static void
+bench_filter (void)
+{
+  GPtrArray *items = make_items (FILTER_ITEMS);
+
+  g_print ("Substring filter over %u apps\n", items->len);
+
+  for (guint i = 0; i < G_N_ELEMENTS (queries); i++) {
+    BenchQuery bench = { items, queries[i] };
+    guint strdown_matches, folded_matches;
+    double strdown_best, folded_best;
+    double strdown_mean = measure (run_filter_strdown, &bench, &strdown_matches, &strdown_best);
+    double folded_mean = measure (run_filter_folded, &bench, &folded_matches, &folded_best);
+
+    g_print ("  %-14s g_utf8_strdown %8.1f us (%5u)  folded keys %8.1f us (%5u)  %5.1fx\n",
+             queries[i], strdown_mean, strdown_matches, folded_mean, folded_matches,
+             folded_mean > 0 ? strdown_mean / folded_mean : 0);
+  }
+
+  g_ptr_array_unref (items);
+}
+
+int
+main (int argc, char **argv)
+{
+  (void)argc;
+  (void)argv;
+
+  gboolean ok = bench_rank ();
+  bench_kernels ();
+  bench_filter ();
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,1059 @@
+#include "app_catalog.h"
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Cache file layout (native endianness, every section 8-byte aligned):
+ *
+ *   CatalogHeader
+ *   CatalogRootRecord[n_roots]     one per XDG applications directory
+ *   CatalogDirRecord[n_dirs]       every directory walked under a root
+ *   CatalogEntryRecord[n_entries]  parsed desktop entries, grouped by root
+ *   char strings[strings_size]     NUL-terminated strings, offset 0 is ""
+ *
+ * The cache is memory-mapped on startup. Roots whose directories all still
+ * match their recorded device/inode/mtime, and whose desktop files still
+ * match their recorded mtime and size, are used straight from the mapping
+ * without opening a single .desktop file. Files edited in place don't
+ * touch their directory's mtime, hence the per-file stamps.
+ */
+
+#define CATALOG_MAGIC "HMCATLG"
+#define CATALOG_VERSION 2
+
+typedef struct {
+  char magic[8];
+  guint32 version;
+  guint32 n_roots;
+  guint32 n_dirs;
+  guint32 n_entries;
+  guint32 strings_size;
+  guint32 locale;
+} CatalogHeader;
+
+typedef struct {
+  guint32 path;
+  guint32 first_dir;
+  guint32 n_dirs;
+  guint32 first_entry;
+  guint32 n_entries;
+  guint32 padding;
+} CatalogRootRecord;
+
+typedef struct {
+  guint64 device;
+  guint64 inode;
+  gint64 mtime;
+  guint32 path;
+  guint32 padding;
+} CatalogDirRecord;
+
+typedef struct {
+  guint32 id;
+  guint32 filename;
+  guint32 name;
+  guint32 generic_name;
+  guint32 comment;
+  guint32 keywords;
+  guint32 categories;
+  guint32 icon;
+  guint32 exec;
+  guint32 try_exec;
+  guint32 only_show_in;
+  guint32 not_show_in;
+  guint32 flags;
+  guint32 padding;
+  gint64 mtime;
+  guint64 size;
+} CatalogEntryRecord;
+
+G_STATIC_ASSERT(sizeof(CatalogHeader) % 8 == 0);
+G_STATIC_ASSERT(sizeof(CatalogRootRecord) % 8 == 0);
+G_STATIC_ASSERT(sizeof(CatalogDirRecord) % 8 == 0);
+G_STATIC_ASSERT(sizeof(CatalogEntryRecord) % 8 == 0);
+
+/* Identity of a directory at the time it was scanned */
+typedef struct {
+  const char *path;
+  guint64 device;
+  guint64 inode;
+  gint64 mtime;
+} DirStamp;
+
+/* State of a desktop file at the time it was parsed */
+typedef struct {
+  gint64 mtime;
+  guint64 size;
+} FileStamp;
+
+typedef struct {
+  const char *path;
+  GArray *dirs;         /* DirStamp */
+  guint first_entry;
+  guint n_entries;
+} CatalogRoot;
+
+struct _HyprMenuAppCatalog {
+  GMappedFile *mapped;  /* Previous cache, backs the strings of reused roots */
+  GStringChunk *strings;
+  GPtrArray *roots;     /* CatalogRoot */
+  GArray *entries;      /* HyprMenuCatalogEntry, all roots */
+  GArray *files;        /* FileStamp, parallel to entries */
+  GArray *visible;      /* guint indices into entries */
+  GHashTable *by_id;    /* Desktop ID -> visible HyprMenuCatalogEntry */
+};
+
+/* Validated view of a mapped cache file */
+typedef struct {
+  const CatalogHeader *header;
+  const CatalogRootRecord *roots;
+  const CatalogDirRecord *dirs;
+  const CatalogEntryRecord *entries;
+  const char *strings;
+} CacheView;
+
+static void
+catalog_root_free(gpointer data)
+{
+  CatalogRoot *root = data;
+  g_array_unref(root->dirs);
+  g_free(root);
+}
+
+static char *
+get_cache_path(void)
+{
+  return g_build_filename(g_get_user_cache_dir(), "hyprmenu", "catalog.bin", NULL);
+}
+
+static const char *
+get_locale_key(void)
+{
+  const char * const *languages = g_get_language_names();
+  return languages[0] ? languages[0] : "C";
+}
+
+static void
+dir_stamp_read(DirStamp *stamp, time_t now)
+{
+  GStatBuf st;
+
+  if (g_stat(stamp->path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+    stamp->device = 0;
+    stamp->inode = 0;
+    stamp->mtime = 0;
+    return;
+  }
+
+  stamp->device = st.st_dev;
+  stamp->inode = st.st_ino;
+  stamp->mtime = st.st_mtime;
+
+  /* mtime has one second granularity here. A directory modified in the
+   * same second it was scanned could change again without its mtime
+   * moving, so don't trust such a stamp: force a rescan next time. */
+  if (now != 0 && st.st_mtime >= now - 1) {
+    stamp->mtime = -1;
+  }
+}
+
+static gboolean
+dir_stamp_is_current(const DirStamp *stamp)
+{
+  DirStamp now = { .path = stamp->path };
+
+  if (stamp->mtime < 0) {
+    return FALSE;
+  }
+
+  dir_stamp_read(&now, 0);
+  return now.device == stamp->device &&
+         now.inode == stamp->inode &&
+         now.mtime == stamp->mtime;
+}
+
+static void
+file_stamp_read(FileStamp *stamp, const char *path, time_t now)
+{
+  GStatBuf st;
+
+  if (!path || g_stat(path, &st) != 0) {
+    stamp->mtime = -1;
+    stamp->size = 0;
+    return;
+  }
+
+  stamp->mtime = st.st_mtime;
+  stamp->size = st.st_size;
+
+  /* Same one second granularity rule as for directories */
+  if (now != 0 && st.st_mtime >= now - 1) {
+    stamp->mtime = -1;
+  }
+}
+
+static gboolean
+file_stamp_is_current(const FileStamp *stamp, const char *path)
+{
+  FileStamp now;
+
+  if (stamp->mtime < 0) {
+    return FALSE;
+  }
+
+  file_stamp_read(&now, path, 0);
+  return now.mtime == stamp->mtime && now.size == stamp->size;
+}
+
+static gboolean
+cache_string_valid(const CacheView *view, guint32 offset)
+{
+  return offset < view->header->strings_size;
+}
+
+static const char *
+cache_string(const CacheView *view, guint32 offset)
+{
+  const char *str = view->strings + offset;
+  return *str ? str : NULL;
+}
+
+static gboolean
+cache_view_init(CacheView *view, GMappedFile *mapped)
+{
+  const char *data = g_mapped_file_get_contents(mapped);
+  gsize length = g_mapped_file_get_length(mapped);
+  const CatalogHeader *header = (const CatalogHeader *)data;
+
+  if (!data || length < sizeof(CatalogHeader)) {
+    return FALSE;
+  }
+
+  if (memcmp(header->magic, CATALOG_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != CATALOG_VERSION) {
+    return FALSE;
+  }
+
+  guint64 roots_offset = sizeof(CatalogHeader);
+  guint64 dirs_offset = roots_offset + (guint64)header->n_roots * sizeof(CatalogRootRecord);
+  guint64 entries_offset = dirs_offset + (guint64)header->n_dirs * sizeof(CatalogDirRecord);
+  guint64 strings_offset = entries_offset + (guint64)header->n_entries * sizeof(CatalogEntryRecord);
+
+  if (header->strings_size == 0 || strings_offset + header->strings_size != length) {
+    return FALSE;
+  }
+
+  view->header = header;
+  view->roots = (const CatalogRootRecord *)(data + roots_offset);
+  view->dirs = (const CatalogDirRecord *)(data + dirs_offset);
+  view->entries = (const CatalogEntryRecord *)(data + entries_offset);
+  view->strings = data + strings_offset;
+
+  /* Every offset below must land on a terminated string */
+  if (view->strings[header->strings_size - 1] != '\0' ||
+      view->strings[0] != '\0' ||
+      !cache_string_valid(view, header->locale)) {
+    return FALSE;
+  }
+
+  if (g_strcmp0(view->strings + header->locale, get_locale_key()) != 0) {
+    g_print("Catalog cache was built for another locale, rebuilding\n");
+    return FALSE;
+  }
+
+  for (guint32 i = 0; i < header->n_roots; i++) {
+    const CatalogRootRecord *root = &view->roots[i];
+    if (!cache_string_valid(view, root->path) ||
+        (guint64)root->first_dir + root->n_dirs > header->n_dirs ||
+        (guint64)root->first_entry + root->n_entries > header->n_entries) {
+      return FALSE;
+    }
+  }
+
+  for (guint32 i = 0; i < header->n_dirs; i++) {
+    if (!cache_string_valid(view, view->dirs[i].path)) {
+      return FALSE;
+    }
+  }
+
+  for (guint32 i = 0; i < header->n_entries; i++) {
+    const CatalogEntryRecord *record = &view->entries[i];
+    const guint32 *offsets = &record->id;
+    for (guint f = 0; f < G_STRUCT_OFFSET(CatalogEntryRecord, flags) / sizeof(guint32); f++) {
+      if (!cache_string_valid(view, offsets[f])) {
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+static GMappedFile *
+open_cache(const char *cache_path, CacheView *view)
+{
+  GError *error = NULL;
+  GMappedFile *mapped = g_mapped_file_new(cache_path, FALSE, &error);
+
+  if (!mapped) {
+    if (!g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+      g_warning("Failed to open catalog cache: %s", error->message);
+    }
+    g_error_free(error);
+    return NULL;
+  }
+
+  if (!cache_view_init(view, mapped)) {
+    g_print("Catalog cache is invalid or outdated, rebuilding\n");
+    g_mapped_file_unref(mapped);
+    return NULL;
+  }
+
+  return mapped;
+}
+
+/* Use a root straight from the cache if none of its directories and
+ * desktop files changed */
+static gboolean
+reuse_cached_root(HyprMenuAppCatalog *self, const CacheView *view, CatalogRoot *root)
+{
+  const CatalogRootRecord *record = NULL;
+
+  for (guint32 i = 0; i < view->header->n_roots; i++) {
+    if (strcmp(view->strings + view->roots[i].path, root->path) == 0) {
+      record = &view->roots[i];
+      break;
+    }
+  }
+
+  if (!record) {
+    return FALSE;
+  }
+
+  for (guint32 i = 0; i < record->n_dirs; i++) {
+    const CatalogDirRecord *dir = &view->dirs[record->first_dir + i];
+    DirStamp stamp = {
+      .path = view->strings + dir->path,
+      .device = dir->device,
+      .inode = dir->inode,
+      .mtime = dir->mtime,
+    };
+
+    if (!dir_stamp_is_current(&stamp)) {
+      g_array_set_size(root->dirs, 0);
+      return FALSE;
+    }
+    g_array_append_val(root->dirs, stamp);
+  }
+
+  for (guint32 i = 0; i < record->n_entries; i++) {
+    const CatalogEntryRecord *rec = &view->entries[record->first_entry + i];
+    FileStamp stamp = { .mtime = rec->mtime, .size = rec->size };
+
+    if (!file_stamp_is_current(&stamp, cache_string(view, rec->filename))) {
+      g_array_set_size(root->dirs, 0);
+      return FALSE;
+    }
+  }
+
+  for (guint32 i = 0; i < record->n_entries; i++) {
+    const CatalogEntryRecord *rec = &view->entries[record->first_entry + i];
+    FileStamp stamp = { .mtime = rec->mtime, .size = rec->size };
+    HyprMenuCatalogEntry entry = {
+      .id = cache_string(view, rec->id),
+      .filename = cache_string(view, rec->filename),
+      .name = cache_string(view, rec->name),
+      .generic_name = cache_string(view, rec->generic_name),
+      .comment = cache_string(view, rec->comment),
+      .keywords = cache_string(view, rec->keywords),
+      .categories = cache_string(view, rec->categories),
+      .icon = cache_string(view, rec->icon),
+      .exec = cache_string(view, rec->exec),
+      .try_exec = cache_string(view, rec->try_exec),
+      .only_show_in = cache_string(view, rec->only_show_in),
+      .not_show_in = cache_string(view, rec->not_show_in),
+      .flags = rec->flags,
+    };
+    g_array_append_val(self->entries, entry);
+    g_array_append_val(self->files, stamp);
+  }
+
+  return TRUE;
+}
+
+static const char *
+intern(HyprMenuAppCatalog *self, const char *str)
+{
+  if (!str || !*str) {
+    return NULL;
+  }
+  return g_string_chunk_insert_const(self->strings, str);
+}
+
+/* A desktop file to parse on a worker thread. Results are plain owned
+ * strings so workers never touch the catalog's string chunk. */
+typedef struct {
+  char *filename;
+  char *id;
+  char *name;
+  char *generic_name;
+  char *comment;
+  char *keywords;
+  char *categories;
+  char *icon;
+  char *exec;
+  char *try_exec;
+  char *only_show_in;
+  char *not_show_in;
+  guint32 flags;
+  FileStamp stamp;      /* Taken before parsing */
+} ParseJob;
+
+static void
+parse_job_free(gpointer data)
+{
+  ParseJob *job = data;
+
+  g_free(job->filename);
+  g_free(job->id);
+  g_free(job->name);
+  g_free(job->generic_name);
+  g_free(job->comment);
+  g_free(job->keywords);
+  g_free(job->categories);
+  g_free(job->icon);
+  g_free(job->exec);
+  g_free(job->try_exec);
+  g_free(job->only_show_in);
+  g_free(job->not_show_in);
+  g_free(job);
+}
+
+/* Parse one desktop file. Entries that can't be launched are kept as
+ * hidden so they still mask entries with the same ID in later roots.
+ * Runs on a worker thread. */
+static void
+parse_desktop_file(gpointer data, gpointer user_data)
+{
+  ParseJob *job = data;
+  GKeyFile *keyfile = g_key_file_new();
+  const char *group = G_KEY_FILE_DESKTOP_GROUP;
+
+  (void)user_data;
+  job->flags = HYPRMENU_CATALOG_ENTRY_HIDDEN;
+
+  if (g_key_file_load_from_file(keyfile, job->filename, G_KEY_FILE_NONE, NULL) &&
+      g_key_file_has_group(keyfile, group)) {
+    char *type = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_TYPE, NULL);
+    gboolean is_app = g_strcmp0(type, G_KEY_FILE_DESKTOP_TYPE_APPLICATION) == 0;
+    g_free(type);
+
+    job->name = g_key_file_get_locale_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_NAME, NULL, NULL);
+    job->generic_name = g_key_file_get_locale_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_GENERIC_NAME, NULL, NULL);
+    job->comment = g_key_file_get_locale_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_COMMENT, NULL, NULL);
+    job->keywords = g_key_file_get_locale_string(keyfile, group, "Keywords", NULL, NULL);
+    job->icon = g_key_file_get_locale_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_ICON, NULL, NULL);
+    job->categories = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_CATEGORIES, NULL);
+    job->exec = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_EXEC, NULL);
+    job->try_exec = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_TRY_EXEC, NULL);
+    job->only_show_in = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_ONLY_SHOW_IN, NULL);
+    job->not_show_in = g_key_file_get_string(keyfile, group, G_KEY_FILE_DESKTOP_KEY_NOT_SHOW_IN, NULL);
+
+    gboolean hidden = g_key_file_get_boolean(keyfile, group, G_KEY_FILE_DESKTOP_KEY_HIDDEN, NULL);
+    gboolean no_display = g_key_file_get_boolean(keyfile, group, G_KEY_FILE_DESKTOP_KEY_NO_DISPLAY, NULL);
+
+    job->flags = 0;
+    if (hidden || !is_app || !job->exec || !*job->exec) {
+      job->flags |= HYPRMENU_CATALOG_ENTRY_HIDDEN;
+    }
+    if (no_display) {
+      job->flags |= HYPRMENU_CATALOG_ENTRY_NO_DISPLAY;
+    }
+  }
+
+  g_key_file_free(keyfile);
+}
+
+/* Walk a directory recursively, queueing every .desktop file. Subdirectory
+ * names become part of the desktop ID ("kde/foo.desktop" -> "kde-foo.desktop") */
+static void
+scan_dir(HyprMenuAppCatalog *self, CatalogRoot *root, const char *path,
+         const char *id_prefix, time_t now, GPtrArray *jobs)
+{
+  DirStamp stamp = { .path = intern(self, path) };
+  dir_stamp_read(&stamp, now);
+  g_array_append_val(root->dirs, stamp);
+
+  GDir *dir = g_dir_open(path, 0, NULL);
+  if (!dir) {
+    return;
+  }
+
+  const char *name;
+  while ((name = g_dir_read_name(dir)) != NULL) {
+    char *child = g_build_filename(path, name, NULL);
+
+    if (g_str_has_suffix(name, ".desktop")) {
+      ParseJob *job = g_new0(ParseJob, 1);
+      job->filename = child;
+      job->id = g_strconcat(id_prefix, name, NULL);
+      file_stamp_read(&job->stamp, child, now);
+      g_ptr_array_add(jobs, job);
+      continue;
+    }
+
+    if (g_file_test(child, G_FILE_TEST_IS_DIR)) {
+      char *prefix = g_strconcat(id_prefix, name, "-", NULL);
+      scan_dir(self, root, child, prefix, now, jobs);
+      g_free(prefix);
+    }
+
+    g_free(child);
+  }
+
+  g_dir_close(dir);
+}
+
+/* Scan a root and parse its desktop files in parallel. Entries are
+ * appended in directory order, so ID precedence stays deterministic. */
+static void
+scan_root(HyprMenuAppCatalog *self, CatalogRoot *root, time_t now)
+{
+  GPtrArray *jobs = g_ptr_array_new_with_free_func(parse_job_free);
+
+  scan_dir(self, root, root->path, "", now, jobs);
+
+  guint n_threads = MIN(g_get_num_processors(), 8);
+  if (jobs->len > 32 && n_threads > 1) {
+    GError *error = NULL;
+    GThreadPool *pool = g_thread_pool_new(parse_desktop_file, NULL, n_threads, FALSE, &error);
+
+    if (pool) {
+      for (guint i = 0; i < jobs->len; i++) {
+        g_thread_pool_push(pool, g_ptr_array_index(jobs, i), NULL);
+      }
+      /* Waits until every queued job has run */
+      g_thread_pool_free(pool, FALSE, TRUE);
+    } else {
+      g_warning("Failed to start parser threads: %s", error->message);
+      g_error_free(error);
+      g_ptr_array_foreach(jobs, parse_desktop_file, NULL);
+    }
+  } else {
+    g_ptr_array_foreach(jobs, parse_desktop_file, NULL);
+  }
+
+  for (guint i = 0; i < jobs->len; i++) {
+    ParseJob *job = g_ptr_array_index(jobs, i);
+    HyprMenuCatalogEntry entry = {
+      .id = intern(self, job->id),
+      .filename = intern(self, job->filename),
+      .name = intern(self, job->name),
+      .generic_name = intern(self, job->generic_name),
+      .comment = intern(self, job->comment),
+      .keywords = intern(self, job->keywords),
+      .categories = intern(self, job->categories),
+      .icon = intern(self, job->icon),
+      .exec = intern(self, job->exec),
+      .try_exec = intern(self, job->try_exec),
+      .only_show_in = intern(self, job->only_show_in),
+      .not_show_in = intern(self, job->not_show_in),
+      .flags = job->flags,
+    };
+    g_array_append_val(self->entries, entry);
+    g_array_append_val(self->files, job->stamp);
+  }
+
+  g_ptr_array_unref(jobs);
+}
+
+static GPtrArray *
+collect_root_paths(void)
+{
+  GPtrArray *paths = g_ptr_array_new_with_free_func(g_free);
+  const char * const *system_dirs = g_get_system_data_dirs();
+
+  g_ptr_array_add(paths, g_build_filename(g_get_user_data_dir(), "applications", NULL));
+  for (guint i = 0; system_dirs[i]; i++) {
+    char *path = g_build_filename(system_dirs[i], "applications", NULL);
+    gboolean duplicate = FALSE;
+
+    for (guint j = 0; j < paths->len; j++) {
+      if (strcmp(g_ptr_array_index(paths, j), path) == 0) {
+        duplicate = TRUE;
+        break;
+      }
+    }
+
+    if (duplicate) {
+      g_free(path);
+    } else {
+      g_ptr_array_add(paths, path);
+    }
+  }
+
+  return paths;
+}
+
+static gboolean
+list_contains(const char *list, const char *item)
+{
+  gsize len = strlen(item);
+
+  for (const char *p = list; p && *p; ) {
+    const char *end = strchr(p, ';');
+    gsize token_len = end ? (gsize)(end - p) : strlen(p);
+
+    if (token_len == len && strncmp(p, item, len) == 0) {
+      return TRUE;
+    }
+    p = end ? end + 1 : NULL;
+  }
+
+  return FALSE;
+}
+
+/* Same rules as g_app_info_should_show() */
+static gboolean
+entry_should_show(const HyprMenuCatalogEntry *entry, char **desktops)
+{
+  if (entry->flags & (HYPRMENU_CATALOG_ENTRY_HIDDEN | HYPRMENU_CATALOG_ENTRY_NO_DISPLAY)) {
+    return FALSE;
+  }
+
+  if (!entry->name || !entry->id) {
+    return FALSE;
+  }
+
+  gboolean show_in = entry->only_show_in == NULL;
+  for (guint i = 0; desktops && desktops[i]; i++) {
+    if (list_contains(entry->only_show_in, desktops[i])) {
+      show_in = TRUE;
+      break;
+    }
+    if (list_contains(entry->not_show_in, desktops[i])) {
+      show_in = FALSE;
+      break;
+    }
+  }
+  if (!show_in) {
+    return FALSE;
+  }
+
+  if (entry->try_exec) {
+    char *program = g_find_program_in_path(entry->try_exec);
+    if (!program) {
+      return FALSE;
+    }
+    g_free(program);
+  }
+
+  return TRUE;
+}
+
+typedef struct {
+  guint index;
+  char *key;
+  const char *id;               /* Borrowed from the entry */
+} SortEntry;
+
+/* The same order as hyprmenu_app_item_compare_by_name(), which the menu
+ * keeps its store in: by name, then by desktop ID */
+static int
+compare_sort_entries(gconstpointer a, gconstpointer b)
+{
+  const SortEntry *entry_a = a;
+  const SortEntry *entry_b = b;
+
+  int result = strcmp(entry_a->key, entry_b->key);
+  return result ? result : strcmp(entry_a->id, entry_b->id);
+}
+
+/* Hand entries out in name order, so the menu can insert them as they
+ * come without sorting. Collation keys are computed once per entry here
+ * on the loading thread instead of on every comparison. */
+static void
+sort_visible(HyprMenuAppCatalog *self)
+{
+  GArray *sorted = g_array_sized_new(FALSE, FALSE, sizeof(SortEntry), self->visible->len);
+
+  for (guint i = 0; i < self->visible->len; i++) {
+    guint index = g_array_index(self->visible, guint, i);
+    const HyprMenuCatalogEntry *entry = &g_array_index(self->entries, HyprMenuCatalogEntry, index);
+    SortEntry sort_entry = { index, g_utf8_collate_key(entry->name ? entry->name : "", -1), entry->id };
+    g_array_append_val(sorted, sort_entry);
+  }
+
+  g_array_sort(sorted, compare_sort_entries);
+
+  for (guint i = 0; i < sorted->len; i++) {
+    SortEntry *sort_entry = &g_array_index(sorted, SortEntry, i);
+    g_array_index(self->visible, guint, i) = sort_entry->index;
+    g_free(sort_entry->key);
+  }
+
+  g_array_unref(sorted);
+}
+
+/* Earlier roots take precedence: the first entry with a given ID wins,
+ * even when it is hidden */
+static void
+build_visible(HyprMenuAppCatalog *self)
+{
+  GHashTable *seen = g_hash_table_new(g_str_hash, g_str_equal);
+  const char *current_desktop = g_getenv("XDG_CURRENT_DESKTOP");
+  char **desktops = current_desktop ? g_strsplit(current_desktop, ":", -1) : NULL;
+
+  for (guint i = 0; i < self->entries->len; i++) {
+    const HyprMenuCatalogEntry *entry = &g_array_index(self->entries, HyprMenuCatalogEntry, i);
+
+    if (!entry->id || !g_hash_table_add(seen, (gpointer)entry->id)) {
+      continue;
+    }
+
+    if (entry_should_show(entry, desktops)) {
+      g_array_append_val(self->visible, i);
+    }
+  }
+
+  sort_visible(self);
+
+  /* entries is complete now, so pointers into it stay valid */
+  for (guint i = 0; i < self->visible->len; i++) {
+    const HyprMenuCatalogEntry *entry = &g_array_index(self->entries, HyprMenuCatalogEntry,
+                                                       g_array_index(self->visible, guint, i));
+    g_hash_table_insert(self->by_id, (gpointer)entry->id, (gpointer)entry);
+  }
+
+  g_strfreev(desktops);
+  g_hash_table_destroy(seen);
+}
+
+static guint32
+pool_add(GByteArray *pool, GHashTable *offsets, const char *str)
+{
+  gpointer value;
+
+  if (!str || !*str) {
+    return 0;
+  }
+
+  if (g_hash_table_lookup_extended(offsets, str, NULL, &value)) {
+    return GPOINTER_TO_UINT(value);
+  }
+
+  guint32 offset = pool->len;
+  g_byte_array_append(pool, (const guint8 *)str, strlen(str) + 1);
+  g_hash_table_insert(offsets, (gpointer)str, GUINT_TO_POINTER(offset));
+  return offset;
+}
+
+static void
+save_cache(HyprMenuAppCatalog *self, const char *cache_path)
+{
+  GByteArray *pool = g_byte_array_new();
+  GHashTable *offsets = g_hash_table_new(g_str_hash, g_str_equal);
+  GArray *roots = g_array_new(FALSE, TRUE, sizeof(CatalogRootRecord));
+  GArray *dirs = g_array_new(FALSE, TRUE, sizeof(CatalogDirRecord));
+  GArray *entries = g_array_sized_new(FALSE, TRUE, sizeof(CatalogEntryRecord), self->entries->len);
+  CatalogHeader header = { .version = CATALOG_VERSION };
+  GError *error = NULL;
+
+  g_byte_array_append(pool, (const guint8 *)"", 1);
+  memcpy(header.magic, CATALOG_MAGIC, sizeof(header.magic));
+  header.locale = pool_add(pool, offsets, get_locale_key());
+
+  for (guint i = 0; i < self->roots->len; i++) {
+    CatalogRoot *root = g_ptr_array_index(self->roots, i);
+    CatalogRootRecord root_record = {
+      .path = pool_add(pool, offsets, root->path),
+      .first_dir = dirs->len,
+      .n_dirs = root->dirs->len,
+      .first_entry = root->first_entry,
+      .n_entries = root->n_entries,
+    };
+    g_array_append_val(roots, root_record);
+
+    for (guint j = 0; j < root->dirs->len; j++) {
+      DirStamp *stamp = &g_array_index(root->dirs, DirStamp, j);
+      CatalogDirRecord dir_record = {
+        .device = stamp->device,
+        .inode = stamp->inode,
+        .mtime = stamp->mtime,
+        .path = pool_add(pool, offsets, stamp->path),
+      };
+      g_array_append_val(dirs, dir_record);
+    }
+  }
+
+  for (guint i = 0; i < self->entries->len; i++) {
+    const HyprMenuCatalogEntry *entry = &g_array_index(self->entries, HyprMenuCatalogEntry, i);
+    const FileStamp *stamp = &g_array_index(self->files, FileStamp, i);
+    CatalogEntryRecord record = {
+      .id = pool_add(pool, offsets, entry->id),
+      .filename = pool_add(pool, offsets, entry->filename),
+      .name = pool_add(pool, offsets, entry->name),
+      .generic_name = pool_add(pool, offsets, entry->generic_name),
+      .comment = pool_add(pool, offsets, entry->comment),
+      .keywords = pool_add(pool, offsets, entry->keywords),
+      .categories = pool_add(pool, offsets, entry->categories),
+      .icon = pool_add(pool, offsets, entry->icon),
+      .exec = pool_add(pool, offsets, entry->exec),
+      .try_exec = pool_add(pool, offsets, entry->try_exec),
+      .only_show_in = pool_add(pool, offsets, entry->only_show_in),
+      .not_show_in = pool_add(pool, offsets, entry->not_show_in),
+      .flags = entry->flags,
+      .mtime = stamp->mtime,
+      .size = stamp->size,
+    };
+    g_array_append_val(entries, record);
+  }
+
+  header.n_roots = roots->len;
+  header.n_dirs = dirs->len;
+  header.n_entries = entries->len;
+  header.strings_size = pool->len;
+
+  GByteArray *data = g_byte_array_sized_new(sizeof(header) +
+                                            roots->len * sizeof(CatalogRootRecord) +
+                                            dirs->len * sizeof(CatalogDirRecord) +
+                                            entries->len * sizeof(CatalogEntryRecord) +
+                                            pool->len);
+  g_byte_array_append(data, (const guint8 *)&header, sizeof(header));
+  g_byte_array_append(data, (const guint8 *)roots->data, roots->len * sizeof(CatalogRootRecord));
+  g_byte_array_append(data, (const guint8 *)dirs->data, dirs->len * sizeof(CatalogDirRecord));
+  g_byte_array_append(data, (const guint8 *)entries->data, entries->len * sizeof(CatalogEntryRecord));
+  g_byte_array_append(data, pool->data, pool->len);
+
+  char *cache_dir = g_path_get_dirname(cache_path);
+  if (g_mkdir_with_parents(cache_dir, 0755) != 0) {
+    g_warning("Failed to create cache directory: %s", cache_dir);
+  } else if (!g_file_set_contents(cache_path, (const char *)data->data, data->len, &error)) {
+    /* g_file_set_contents() writes a temporary file and renames it, so a
+     * running instance that still has the old cache mapped is unaffected */
+    g_warning("Failed to write catalog cache: %s", error->message);
+    g_error_free(error);
+  } else {
+    g_print("Catalog cache written: %u entries, %u bytes\n", header.n_entries, data->len);
+  }
+
+  g_free(cache_dir);
+  g_byte_array_unref(data);
+  g_array_unref(entries);
+  g_array_unref(dirs);
+  g_array_unref(roots);
+  g_hash_table_destroy(offsets);
+  g_byte_array_unref(pool);
+}
+
+HyprMenuAppCatalog *
+hyprmenu_app_catalog_load(void)
+{
+  HyprMenuAppCatalog *self = g_new0(HyprMenuAppCatalog, 1);
+  CacheView view = { 0 };
+  char *cache_path = get_cache_path();
+  GPtrArray *root_paths = collect_root_paths();
+  time_t now = time(NULL);
+  guint reused = 0;
+
+  self->strings = g_string_chunk_new(16384);
+  self->roots = g_ptr_array_new_with_free_func(catalog_root_free);
+  self->entries = g_array_new(FALSE, FALSE, sizeof(HyprMenuCatalogEntry));
+  self->files = g_array_new(FALSE, FALSE, sizeof(FileStamp));
+  self->visible = g_array_new(FALSE, FALSE, sizeof(guint));
+  self->by_id = g_hash_table_new(g_str_hash, g_str_equal);
+  self->mapped = open_cache(cache_path, &view);
+
+  for (guint i = 0; i < root_paths->len; i++) {
+    CatalogRoot *root = g_new0(CatalogRoot, 1);
+    root->path = intern(self, g_ptr_array_index(root_paths, i));
+    root->dirs = g_array_new(FALSE, FALSE, sizeof(DirStamp));
+    root->first_entry = self->entries->len;
+
+    if (self->mapped && reuse_cached_root(self, &view, root)) {
+      reused++;
+    } else {
+      g_print("Scanning application directory: %s\n", root->path);
+      scan_root(self, root, now);
+    }
+
+    root->n_entries = self->entries->len - root->first_entry;
+    g_ptr_array_add(self->roots, root);
+  }
+
+  build_visible(self);
+  g_print("Application catalog loaded: %u apps (%u of %u directories from cache)\n",
+          self->visible->len, reused, self->roots->len);
+
+  /* Rewrite the cache if any root was rescanned or the set of roots changed */
+  if (!self->mapped || reused != self->roots->len || view.header->n_roots != self->roots->len) {
+    save_cache(self, cache_path);
+  }
+
+  g_ptr_array_unref(root_paths);
+  g_free(cache_path);
+  return self;
+}
+
+static void
+load_thread(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)task_data;
+  (void)cancellable;
+
+  g_task_return_pointer(task, hyprmenu_app_catalog_load(),
+                        (GDestroyNotify)hyprmenu_app_catalog_free);
+}
+
+void
+hyprmenu_app_catalog_load_async(GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data)
+{
+  GTask *task = g_task_new(NULL, cancellable, callback, user_data);
+  g_task_set_source_tag(task, hyprmenu_app_catalog_load_async);
+  g_task_run_in_thread(task, load_thread);
+  g_object_unref(task);
+}
+
+HyprMenuAppCatalog *
+hyprmenu_app_catalog_load_finish(GAsyncResult *result, GError **error)
+{
+  g_return_val_if_fail(g_task_is_valid(result, NULL), NULL);
+
+  return g_task_propagate_pointer(G_TASK(result), error);
+}
+
+void
+hyprmenu_app_catalog_free(HyprMenuAppCatalog *self)
+{
+  if (!self) {
+    return;
+  }
+
+  g_hash_table_destroy(self->by_id);
+  g_array_unref(self->visible);
+  g_array_unref(self->files);
+  g_array_unref(self->entries);
+  g_ptr_array_unref(self->roots);
+  g_string_chunk_free(self->strings);
+  if (self->mapped) {
+    g_mapped_file_unref(self->mapped);
+  }
+  g_free(self);
+}
+
+gboolean
+hyprmenu_app_catalog_is_current(HyprMenuAppCatalog *self)
+{
+  g_return_val_if_fail(self != NULL, FALSE);
+
+  for (guint i = 0; i < self->roots->len; i++) {
+    CatalogRoot *root = g_ptr_array_index(self->roots, i);
+    for (guint j = 0; j < root->dirs->len; j++) {
+      if (!dir_stamp_is_current(&g_array_index(root->dirs, DirStamp, j))) {
+        return FALSE;
+      }
+    }
+  }
+
+  /* Editing a desktop file in place leaves its directory's mtime alone */
+  for (guint i = 0; i < self->entries->len; i++) {
+    const HyprMenuCatalogEntry *entry = &g_array_index(self->entries, HyprMenuCatalogEntry, i);
+    if (!file_stamp_is_current(&g_array_index(self->files, FileStamp, i), entry->filename)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+guint
+hyprmenu_app_catalog_get_n_entries(HyprMenuAppCatalog *self)
+{
+  g_return_val_if_fail(self != NULL, 0);
+  return self->visible->len;
+}
+
+const HyprMenuCatalogEntry *
+hyprmenu_app_catalog_get_entry(HyprMenuAppCatalog *self, guint index)
+{
+  g_return_val_if_fail(self != NULL, NULL);
+  g_return_val_if_fail(index < self->visible->len, NULL);
+
+  guint entry_index = g_array_index(self->visible, guint, index);
+  return &g_array_index(self->entries, HyprMenuCatalogEntry, entry_index);
+}
+
+const HyprMenuCatalogEntry *
+hyprmenu_app_catalog_lookup(HyprMenuAppCatalog *self, const char *id)
+{
+  g_return_val_if_fail(self != NULL, NULL);
+  g_return_val_if_fail(id != NULL, NULL);
+
+  return g_hash_table_lookup(self->by_id, id);
+}
+
+GPtrArray *
+hyprmenu_app_catalog_get_directories(HyprMenuAppCatalog *self)
+{
+  g_return_val_if_fail(self != NULL, NULL);
+
+  GPtrArray *dirs = g_ptr_array_new();
+  for (guint i = 0; i < self->roots->len; i++) {
+    CatalogRoot *root = g_ptr_array_index(self->roots, i);
+    for (guint j = 0; j < root->dirs->len; j++) {
+      g_ptr_array_add(dirs, (gpointer)g_array_index(root->dirs, DirStamp, j).path);
+    }
+  }
+
+  return dirs;
+}
+
+gboolean
+hyprmenu_catalog_entry_equal(const HyprMenuCatalogEntry *a, const HyprMenuCatalogEntry *b)
+{
+  return g_strcmp0(a->id, b->id) == 0 &&
+         g_strcmp0(a->filename, b->filename) == 0 &&
+         g_strcmp0(a->name, b->name) == 0 &&
+         g_strcmp0(a->generic_name, b->generic_name) == 0 &&
+         g_strcmp0(a->comment, b->comment) == 0 &&
+         g_strcmp0(a->keywords, b->keywords) == 0 &&
+         g_strcmp0(a->categories, b->categories) == 0 &&
+         g_strcmp0(a->icon, b->icon) == 0 &&
+         g_strcmp0(a->exec, b->exec) == 0 &&
+         g_strcmp0(a->try_exec, b->try_exec) == 0 &&
+         g_strcmp0(a->only_show_in, b->only_show_in) == 0 &&
+         g_strcmp0(a->not_show_in, b->not_show_in) == 0 &&
+         a->flags == b->flags;
+}
+
+GIcon *
+hyprmenu_catalog_icon_new(const char *icon_name)
+{
+  if (!icon_name || !*icon_name) {
+    return NULL;
+  }
+
+  if (g_path_is_absolute(icon_name)) {
+    GFile *file = g_file_new_for_path(icon_name);
+    GIcon *icon = g_file_icon_new(file);
+    g_object_unref(file);
+    return icon;
+  }
+
+  /* Like GDesktopAppInfo, drop legacy image extensions from themed names */
+  char *name = g_strdup(icon_name);
+  char *ext = strrchr(name, '.');
+  if (ext && (strcmp(ext, ".png") == 0 || strcmp(ext, ".xpm") == 0 || strcmp(ext, ".svg") == 0)) {
+    *ext = '\0';
+  }
+
+  GIcon *icon = g_themed_icon_new(name);
+  g_free(name);
+  return icon;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+/* Flags stored for every cached desktop entry */
+typedef enum {
+  HYPRMENU_CATALOG_ENTRY_NO_DISPLAY = 1 << 0,  /* NoDisplay=true */
+  HYPRMENU_CATALOG_ENTRY_HIDDEN     = 1 << 1,  /* Hidden=true, or not a launchable application */
+} HyprMenuCatalogEntryFlags;
+
+/**
+ * A desktop entry as stored in the catalog. Strings are owned by the
+ * catalog (they may point into the memory-mapped cache file) and stay
+ * valid until the catalog is freed. Missing keys are NULL.
+ */
+typedef struct {
+  const char *id;             /* Desktop file ID, e.g. "org.gnome.Nautilus.desktop" */
+  const char *filename;       /* Absolute path of the .desktop file */
+  const char *name;
+  const char *generic_name;
+  const char *comment;
+  const char *keywords;       /* ';'-separated */
+  const char *categories;     /* ';'-separated */
+  const char *icon;
+  const char *exec;
+  const char *try_exec;
+  const char *only_show_in;   /* ';'-separated */
+  const char *not_show_in;    /* ';'-separated */
+  guint32 flags;              /* HyprMenuCatalogEntryFlags */
+} HyprMenuCatalogEntry;
+
+typedef struct _HyprMenuAppCatalog HyprMenuAppCatalog;
+
+/**
+ * Load the application catalog. The on-disk cache in
+ * $XDG_CACHE_HOME/hyprmenu is validated with one stat() per application
+ * directory and desktop file; only roots that changed are rescanned, and
+ * the cache is rewritten when anything changed.
+ * @return A new catalog, free with hyprmenu_app_catalog_free()
+ */
+HyprMenuAppCatalog* hyprmenu_app_catalog_load(void);
+
+/**
+ * Load the catalog on a worker thread. Desktop files that need parsing
+ * are spread over a thread pool; the callback runs on the calling
+ * thread's main context.
+ * @param cancellable Optional GCancellable; a cancelled load reports G_IO_ERROR_CANCELLED
+ * @param callback Called when the catalog is ready
+ * @param user_data Data for the callback
+ */
+void hyprmenu_app_catalog_load_async(GCancellable* cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data);
+
+/**
+ * Finish hyprmenu_app_catalog_load_async()
+ * @return A new catalog, or NULL with @error set
+ */
+HyprMenuAppCatalog* hyprmenu_app_catalog_load_finish(GAsyncResult* result, GError** error);
+
+/**
+ * Free a catalog and every entry it handed out
+ * @param self The catalog
+ */
+void hyprmenu_app_catalog_free(HyprMenuAppCatalog* self);
+
+/**
+ * Check whether the application directories and every desktop file in
+ * them are unchanged since the catalog was loaded
+ * @param self The catalog
+ * @return TRUE if the catalog still reflects the installed applications
+ */
+gboolean hyprmenu_app_catalog_is_current(HyprMenuAppCatalog* self);
+
+/**
+ * Get the number of entries that should be shown in the menu
+ * @param self The catalog
+ * @return The number of visible entries
+ */
+guint hyprmenu_app_catalog_get_n_entries(HyprMenuAppCatalog* self);
+
+/**
+ * Get a visible entry. Entries are in name order.
+ * @param self The catalog
+ * @param index Index below hyprmenu_app_catalog_get_n_entries()
+ * @return The entry, owned by the catalog
+ */
+const HyprMenuCatalogEntry* hyprmenu_app_catalog_get_entry(HyprMenuAppCatalog* self, guint index);
+
+/**
+ * Look up a visible entry by desktop ID
+ * @param self The catalog
+ * @param id The desktop file ID
+ * @return The entry, or NULL if no visible entry has this ID
+ */
+const HyprMenuCatalogEntry* hyprmenu_app_catalog_lookup(HyprMenuAppCatalog* self, const char* id);
+
+/**
+ * List every directory the catalog was built from, so callers can
+ * watch them for changes
+ * @param self The catalog
+ * @return A new array of paths owned by the catalog, free with g_ptr_array_unref()
+ */
+GPtrArray* hyprmenu_app_catalog_get_directories(HyprMenuAppCatalog* self);
+
+/**
+ * Compare two entries field by field
+ * @return TRUE if both entries would be displayed, shown and launched identically
+ */
+gboolean hyprmenu_catalog_entry_equal(const HyprMenuCatalogEntry* a, const HyprMenuCatalogEntry* b);
+
+/**
+ * Create the icon for an entry's Icon key, like GDesktopAppInfo does
+ * @param icon_name The Icon value (a themed name or an absolute path), may be NULL
+ * @return A new GIcon, or NULL if the entry has no icon
+ */
+GIcon* hyprmenu_catalog_icon_new(const char* icon_name);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(HyprMenuAppCatalog, hyprmenu_app_catalog_free)
+
+G_END_DECLS
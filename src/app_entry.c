@@ -5,16 +5,14 @@
 
 // Function declarations
 static void on_clicked(GtkGestureClick *gesture, gint n_press, double x, double y, gpointer user_data);
-static void launch_application(GDesktopAppInfo *app_info, GtkWidget *widget);
+static void launch_application(HyprMenuAppItem *item, GtkWidget *widget);
 
 struct _HyprMenuAppEntry
 {
   GtkButton parent_instance;
   
-  GDesktopAppInfo *app_info;
-  char *app_id;
-  char *app_name;
-  char **categories;
+  HyprMenuAppItem *item;  // Shared app model, also bound by the list view
+  const char *app_name;   // Owned by item
   
   GtkWidget *main_box;
   GtkWidget *icon;
@@ -119,8 +117,8 @@ on_clicked(GtkGestureClick *gesture,
     return;
   }
   
-  if (!self->app_info) {
-    g_warning("LAUNCH ERROR: App info is NULL for entry %s", 
+  if (!self->item) {
+    g_warning("LAUNCH ERROR: App item is NULL for entry %s", 
               self->app_name ? self->app_name : "(unknown)");
     return;
   }
@@ -128,7 +126,7 @@ on_clicked(GtkGestureClick *gesture,
   g_print("DEBUG: Launching application: %s\n", self->app_name ? self->app_name : "(unknown)");
   
   // Launch the application
-  launch_application(self->app_info, GTK_WIDGET(self));
+  launch_application(self->item, GTK_WIDGET(self));
 }
 
 static void
@@ -161,10 +159,7 @@ hyprmenu_app_entry_finalize (GObject *object)
 {
   HyprMenuAppEntry *self = HYPRMENU_APP_ENTRY (object);
   
-  g_clear_object (&self->app_info);
-  g_free (self->app_id);
-  g_free (self->app_name);
-  g_strfreev (self->categories);
+  g_clear_object (&self->item);
   
   G_OBJECT_CLASS (hyprmenu_app_entry_parent_class)->finalize (object);
 }
@@ -204,11 +199,8 @@ create_list_layout(HyprMenuAppEntry *self)
   gtk_box_append(GTK_BOX(icon_box), icon);
   
   // Try to replace with actual app icon if available
-  if (self->app_info) {
-    GIcon *app_icon = g_app_info_get_icon(G_APP_INFO(self->app_info));
-    if (app_icon) {
-      gtk_image_set_from_gicon(GTK_IMAGE(icon), app_icon);
-    }
+  if (self->item && hyprmenu_app_item_get_icon(self->item)) {
+    gtk_image_set_from_gicon(GTK_IMAGE(icon), hyprmenu_app_item_get_icon(self->item));
   }
   
   self->icon = icon;
@@ -268,11 +260,8 @@ create_grid_layout(HyprMenuAppEntry *self)
   gtk_box_append(GTK_BOX(icon_box), icon);
   
   // Try to replace with actual app icon if available
-  if (self->app_info) {
-    GIcon *app_icon = g_app_info_get_icon(G_APP_INFO(self->app_info));
-    if (app_icon) {
-      gtk_image_set_from_gicon(GTK_IMAGE(icon), app_icon);
-    }
+  if (self->item && hyprmenu_app_item_get_icon(self->item)) {
+    gtk_image_set_from_gicon(GTK_IMAGE(icon), hyprmenu_app_item_get_icon(self->item));
   }
   
   self->icon = icon;
@@ -390,65 +379,63 @@ hyprmenu_app_entry_class_init (HyprMenuAppEntryClass *klass)
   object_class->finalize = hyprmenu_app_entry_finalize;
 }
 
-HyprMenuAppEntry *
-hyprmenu_app_entry_new (GDesktopAppInfo *app_info)
+/* Show the current item in the existing icon and label */
+static void
+update_item_widgets (HyprMenuAppEntry *self)
 {
-  if (!app_info) {
-    g_warning("app_entry_new: Attempted to create entry with NULL app_info");
-    return NULL;
+  if (GTK_IS_IMAGE(self->icon)) {
+    GIcon *gicon = self->item ? hyprmenu_app_item_get_icon(self->item) : NULL;
+    if (gicon) {
+      gtk_image_set_from_gicon(GTK_IMAGE(self->icon), gicon);
+    } else {
+      gtk_image_set_from_icon_name(GTK_IMAGE(self->icon), "application-x-executable");
+    }
   }
-
-  const char *app_name = g_app_info_get_name(G_APP_INFO(app_info));
-  if (!app_name || *app_name == '\0') {
-    g_warning("app_entry_new: App has no name or empty name, skipping");
-    return NULL;
+  
+  if (GTK_IS_LABEL(self->name_label)) {
+    char *markup = g_markup_printf_escaped(self->is_grid_layout ?
+                                           "<span size='small'>%s</span>" :
+                                           "<span weight='bold' size='large'>%s</span>",
+                                           self->app_name ? self->app_name : "Unknown");
+    gtk_label_set_markup(GTK_LABEL(self->name_label), markup);
+    g_free(markup);
   }
+}
 
+HyprMenuAppEntry *
+hyprmenu_app_entry_new (HyprMenuAppItem *item)
+{
   HyprMenuAppEntry *self = g_object_new (HYPRMENU_TYPE_APP_ENTRY, NULL);
   
-  /* Store app info */
-  self->app_info = g_object_ref (app_info);
-  self->app_id = g_strdup (g_app_info_get_id (G_APP_INFO (app_info)));
-  self->app_name = g_strdup (app_name);
+  if (item) {
+    hyprmenu_app_entry_set_item (self, item);
+  }
   
-  /* Get categories */
-  self->categories = NULL;
-  const char *categories_str = g_desktop_app_info_get_categories(app_info);
+  return self;
+}
+
+void
+hyprmenu_app_entry_set_item (HyprMenuAppEntry *self, HyprMenuAppItem *item)
+{
+  g_return_if_fail(HYPRMENU_IS_APP_ENTRY(self));
+  g_return_if_fail(item == NULL || HYPRMENU_IS_APP_ITEM(item));
   
-  if (categories_str && g_utf8_validate(categories_str, -1, NULL)) {
-    // Parse only if valid UTF-8
-    self->categories = g_strsplit(categories_str, ";", -1);
-    
-    // Verify we got valid categories
-    if (!self->categories || !self->categories[0] || !self->categories[0][0]) {
-      // Invalid or empty categories, free and set to default
-      if (self->categories) {
-        g_strfreev(self->categories);
-      }
-      self->categories = g_strsplit("Other", ";", -1);
-    }
-  } else {
-    // Default category
-    self->categories = g_strsplit("Other", ";", -1);
-  }
+  if (self->item == item) return;
   
-  // Note: Icon and label text are now set directly in the layout functions
+  /* Store app info */
+  g_set_object (&self->item, item);
+  self->app_name = item ? hyprmenu_app_item_get_name(item) : NULL;
   
-  return self;
+  /* Recycled tiles keep their widgets; only the content changes */
+  update_item_widgets (self);
 }
 
 int
 hyprmenu_app_entry_compare_by_name(HyprMenuAppEntry *a, HyprMenuAppEntry *b)
 {
-  if (!a || !b) return 0;
-  
-  const char *name_a = hyprmenu_app_entry_get_app_name(a);
-  const char *name_b = hyprmenu_app_entry_get_app_name(b);
+  if (!a || !b || !a->item || !b->item) return 0;
   
-  if (!name_a) name_a = "";
-  if (!name_b) name_b = "";
-  
-  return g_ascii_strcasecmp(name_a, name_b);
+  return hyprmenu_app_item_compare_by_name(a->item, b->item, NULL);
 }
 
 const char *
@@ -460,24 +447,18 @@ hyprmenu_app_entry_get_app_name (HyprMenuAppEntry *self)
 const char *
 hyprmenu_app_entry_get_app_id (HyprMenuAppEntry *self)
 {
-  return self->app_id;
+  return self->item ? hyprmenu_app_item_get_id(self->item) : NULL;
 }
 
-const char **
-hyprmenu_app_entry_get_categories (HyprMenuAppEntry *self)
+const char *
+hyprmenu_app_entry_get_category (HyprMenuAppEntry *self)
 {
   if (!self) {
-    g_warning("hyprmenu_app_entry_get_categories: NULL self pointer");
+    g_warning("hyprmenu_app_entry_get_category: NULL self pointer");
     return NULL;
   }
   
-  if (!self->categories) {
-    g_warning("hyprmenu_app_entry_get_categories: NULL categories for app %s", 
-              self->app_name ? self->app_name : "(unknown)");
-    return NULL;
-  }
-  
-  return (const char **) self->categories;
+  return self->item ? hyprmenu_app_item_get_category(self->item) : "Other";
 }
 
 /**
@@ -523,15 +504,15 @@ hyprmenu_app_entry_set_grid_layout (HyprMenuAppEntry *self, gboolean is_grid)
   }
 }
 
-GDesktopAppInfo*
-hyprmenu_app_entry_get_app_info (HyprMenuAppEntry *self)
+HyprMenuAppItem*
+hyprmenu_app_entry_get_item (HyprMenuAppEntry *self)
 {
   if (!self) {
-    g_warning("hyprmenu_app_entry_get_app_info: NULL self pointer");
+    g_warning("hyprmenu_app_entry_get_item: NULL self pointer");
     return NULL;
   }
   
-  return self->app_info;
+  return self->item;
 }
 
 void
@@ -542,7 +523,7 @@ hyprmenu_app_entry_launch (HyprMenuAppEntry *self)
     return;
   }
   
-  launch_application(self->app_info, GTK_WIDGET(self));
+  launch_application(self->item, GTK_WIDGET(self));
 }
 
 GIcon*
@@ -550,11 +531,7 @@ hyprmenu_app_entry_get_icon (HyprMenuAppEntry *self)
 {
   g_return_val_if_fail(HYPRMENU_IS_APP_ENTRY(self), NULL);
   
-  if (self->app_info) {
-    return g_app_info_get_icon(G_APP_INFO(self->app_info));
-  }
-  
-  return NULL;
+  return self->item ? hyprmenu_app_item_get_icon(self->item) : NULL;
 }
 
 void
@@ -590,12 +567,12 @@ update_layout(HyprMenuAppEntry *self)
 
 // Add the launch_application function back
 static void
-launch_application(GDesktopAppInfo *app_info, GtkWidget *widget)
+launch_application(HyprMenuAppItem *item, GtkWidget *widget)
 {
   g_print("DEBUG: launch_application() called\n");
   
-  if (!app_info) {
-    g_warning("LAUNCH ERROR: app_info is NULL");
+  if (!item) {
+    g_warning("LAUNCH ERROR: item is NULL");
     return;
   }
   
@@ -604,15 +581,9 @@ launch_application(GDesktopAppInfo *app_info, GtkWidget *widget)
     return;
   }
   
-  const char *app_name = g_app_info_get_name(G_APP_INFO(app_info));
-  const char *app_cmd = g_app_info_get_commandline(G_APP_INFO(app_info));
-  g_print("DEBUG: Launching app '%s' with command: %s\n", 
-          app_name ? app_name : "(unknown)", 
-          app_cmd ? app_cmd : "(unknown)");
-  
   GError *error = NULL;
   
-  if (!g_app_info_launch(G_APP_INFO(app_info), NULL, NULL, &error)) {
+  if (!hyprmenu_app_item_launch(item, &error)) {
     g_warning("Failed to launch application: %s", error->message);
     g_error_free(error);
     return;
@@ -636,5 +607,5 @@ hyprmenu_app_entry_activate(HyprMenuAppEntry *self)
 {
   g_return_if_fail(HYPRMENU_IS_APP_ENTRY(self));
   
-  launch_application(self->app_info, GTK_WIDGET(self));
+  launch_application(self->item, GTK_WIDGET(self));
 }
\ No newline at end of file
@@ -1,23 +1,50 @@
 #include "app_grid.h"
 #include "category_list.h"
+#include "app_item.h"
+#include "app_catalog.h"
 #include "app_entry.h"
+#include "launch_history.h"
+#include "search.h"
+#include "search_index.h"
+#include "search_view.h"
 #include "config.h"
-#include <gio-unix-2.0/gio/gdesktopappinfo.h>
 #include <gdk/gdk.h>
-#include <unistd.h> // For sync() function
+#include <string.h>
 
 struct _HyprMenuAppGrid
 {
   GtkBox parent_instance;
   
-  GtkWidget *category_list;    // Grid view
-  GtkWidget *list_view;        // List view
-  GtkWidget *scrolled_window;
+  GtkWidget *category_list;    // Grid view, NULL until first shown
+  GtkWidget *list_view;        // List view, NULL until first shown
+  GtkWidget *search_view;      // Ranked results while searching, NULL until first search
+  GtkWidget *recent_box;       // Most frecent apps above the views, hidden while searching
+  GtkWidget *view_stack;       // Every view built so far; each scrolls itself
   GtkWidget *toggle_button;    // Toggle button for grid/list view
   GtkWidget *current_view;     // Points to either category_list or list_view
+  GtkWidget *shown_view;       // current_view, or search_view while searching
   
-  GArray *app_entries;
+  GListStore *apps;            // HyprMenuAppItem, shared by both views
+  GHashTable *items_by_id;     // Desktop ID -> HyprMenuAppItem in apps
   char *filter_text;
+  char *filter_key;            // Folded search text, NULL when not searching
+  HyprMenuSearchIndex *search_index;  // Over apps; dropped when apps changes, unused while populating
+  GPtrArray *search_levels;    // SearchLevel stack; each query extends the one below
+  GCancellable *search_cancellable;  // Set while a ranking runs on the worker pool
+  
+  // Desktop entries backing both views; stale forces a full reload on next show
+  HyprMenuAppCatalog *catalog;
+  gboolean stale;
+  
+  // Change notification for incremental updates
+  GAppInfoMonitor *app_monitor;
+  GHashTable *dir_monitors;    // Directory path -> GFileMonitor
+  guint update_source_id;      // Pending coalesced catalog update
+  
+  // Catalogs are loaded on a worker thread and inserted over several frames
+  GCancellable *load_cancellable;  // Set while a catalog load is in flight
+  guint populate_source_id;
+  guint populate_index;            // Next catalog entry to insert
   
   // Add event controller for key events
   GtkEventController *key_controller;
@@ -25,6 +52,10 @@ struct _HyprMenuAppGrid
 
 G_DEFINE_TYPE (HyprMenuAppGrid, hyprmenu_app_grid, GTK_TYPE_BOX)
 
+/* Time spent inserting rows per main loop iteration, so the window can
+ * paint and handle input while a full catalog is being added */
+#define POPULATE_BATCH_BUDGET_US 4000
+
 static void
 close_window(GtkWidget *widget)
 {
@@ -88,23 +119,676 @@ on_toggle_view_clicked(GtkButton *button, gpointer user_data)
   hyprmenu_app_grid_toggle_view(self);
 }
 
+/* Matches of one query. Every match of a query also matches its
+ * prefixes, so a longer query only needs to rescore these; only the
+ * best few are sorted and shown. */
+typedef struct {
+  char *query;                 // Folded query
+  GArray *matches;             // HyprMenuSearchResult for every match
+  GArray *top;                 // The best of matches shown, best first
+} SearchLevel;
+
+/* Levels kept for backspacing; typing past this drops the oldest */
+#define MAX_SEARCH_LEVELS 16
+
+static void
+search_level_free(gpointer data)
+{
+  SearchLevel *level = data;
+  
+  g_free(level->query);
+  g_array_unref(level->matches);
+  g_array_unref(level->top);
+  g_free(level);
+}
+
+static void
+show_view(HyprMenuAppGrid *self, GtkWidget *view)
+{
+  if (view == self->shown_view) {
+    return;
+  }
+  
+  /* Views stay in the stack once built, bound to the same model, so
+   * switching only changes which one is mapped */
+  if (!gtk_widget_get_parent(view)) {
+    gtk_stack_add_child(GTK_STACK(self->view_stack), view);
+  }
+  gtk_stack_set_visible_child(GTK_STACK(self->view_stack), view);
+  self->shown_view = view;
+}
+
+static void
+cancel_search(HyprMenuAppGrid *self)
+{
+  if (self->search_cancellable) {
+    g_cancellable_cancel(self->search_cancellable);
+    g_clear_object(&self->search_cancellable);
+  }
+}
+
+static void
+on_apps_changed(GListModel *model, guint position, guint removed, guint added, gpointer user_data)
+{
+  (void)model;
+  (void)position;
+  (void)removed;
+  (void)added;
+  
+  /* Rebuilt by the next search, unless the catalog is still being
+   * populated: search_candidates() scans linearly until then */
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  cancel_search(self);
+  g_clear_pointer(&self->search_index, hyprmenu_search_index_free);
+  g_ptr_array_set_size(self->search_levels, 0);
+}
+
+static SearchLevel *
+push_search_level(HyprMenuAppGrid *self, GArray *matches)
+{
+  SearchLevel *level = g_new(SearchLevel, 1);
+  level->query = g_strdup(self->filter_key);
+  level->matches = matches;
+  level->top = hyprmenu_search_top(matches, config->max_search_results);
+  
+  if (self->search_levels->len == MAX_SEARCH_LEVELS) {
+    g_ptr_array_remove_index(self->search_levels, 0);
+  }
+  g_ptr_array_add(self->search_levels, level);
+  return level;
+}
+
+static void
+show_search_level(HyprMenuAppGrid *self, SearchLevel *level)
+{
+  GArray *top = level->top;
+  HyprMenuAppItem **items = g_new(HyprMenuAppItem *, MAX(top->len, 1));
+  
+  for (guint i = 0; i < top->len; i++) {
+    items[i] = g_array_index(top, HyprMenuSearchResult, i).item;
+  }
+  hyprmenu_search_view_set_results(HYPRMENU_SEARCH_VIEW(self->search_view),
+                                   level->query, items, top->len);
+  g_free(items);
+  
+  show_view(self, self->search_view);
+}
+
+/* The apps of the previous level, or the index candidates when there is
+ * no previous level to narrow */
+static GPtrArray *
+search_candidates(HyprMenuAppGrid *self, SearchLevel *previous)
+{
+  if (previous) {
+    GPtrArray *candidates = g_ptr_array_sized_new(previous->matches->len);
+    for (guint i = 0; i < previous->matches->len; i++) {
+      g_ptr_array_add(candidates, g_array_index(previous->matches, HyprMenuSearchResult, i).item);
+    }
+    return candidates;
+  }
+  
+  /* Every populate batch changes the store and would drop a fresh index
+   * again, so scan all apps until the catalog is in; the ranking's mask
+   * test still skips most of them without reading their keys */
+  if (self->populate_source_id) {
+    guint n_apps = g_list_model_get_n_items(G_LIST_MODEL(self->apps));
+    GPtrArray *candidates = g_ptr_array_sized_new(MAX(n_apps, 1));
+    for (guint i = 0; i < n_apps; i++) {
+      HyprMenuAppItem *item = g_list_model_get_item(G_LIST_MODEL(self->apps), i);
+      g_ptr_array_add(candidates, item);
+      g_object_unref(item);  /* The store keeps it */
+    }
+    return candidates;
+  }
+  
+  if (!self->search_index) {
+    self->search_index = hyprmenu_search_index_new(G_LIST_MODEL(self->apps));
+  }
+  
+  /* Only apps containing every query character are scored */
+  return hyprmenu_search_index_candidates(self->search_index,
+                                          self->filter_key, strlen(self->filter_key));
+}
+
+static void
+on_search_ranked(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+  (void)source;
+  
+  GError *error = NULL;
+  GArray *matches = hyprmenu_search_rank_finish(result, &error);
+  
+  /* Newer input or an app list change cancelled this ranking */
+  if (!matches) {
+    if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+      g_warning("Failed to rank search results: %s", error->message);
+    }
+    g_error_free(error);
+    return;
+  }
+  
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  g_clear_object(&self->search_cancellable);
+  show_search_level(self, push_search_level(self, matches));
+}
+
+static void
+update_recent_visibility(HyprMenuAppGrid *self)
+{
+  gtk_widget_set_visible(self->recent_box,
+                         !self->filter_key && gtk_widget_get_first_child(self->recent_box) != NULL);
+}
+
+/* Fill the recent row from the launch history, skipping apps that are
+ * no longer installed */
+static void
+update_recent_apps(HyprMenuAppGrid *self)
+{
+  GtkWidget *child;
+  while ((child = gtk_widget_get_first_child(self->recent_box))) {
+    gtk_box_remove(GTK_BOX(self->recent_box), child);
+  }
+  
+  guint limit = MAX(config->max_recent_apps, 0);
+  GPtrArray *ids = hyprmenu_launch_history_get_top(hyprmenu_launch_history_get_default(), G_MAXUINT);
+  guint n_shown = 0;
+  
+  for (guint i = 0; i < ids->len && n_shown < limit; i++) {
+    HyprMenuAppItem *item = g_hash_table_lookup(self->items_by_id, g_ptr_array_index(ids, i));
+    if (!item) {
+      continue;
+    }
+    
+    HyprMenuAppEntry *entry = hyprmenu_app_entry_new(item);
+    hyprmenu_app_entry_set_grid_layout(entry, TRUE);
+    gtk_widget_set_size_request(GTK_WIDGET(entry), config->grid_item_size, config->grid_item_size);
+    hyprmenu_app_entry_set_icon_size(entry, config->grid_item_size * 0.6);
+    gtk_box_append(GTK_BOX(self->recent_box), GTK_WIDGET(entry));
+    n_shown++;
+  }
+  
+  g_ptr_array_unref(ids);
+  update_recent_visibility(self);
+}
+
+/* Rank the apps that can match the query and show them best first. The
+ * category views are left alone while a query is active. */
+static void
+update_search_results(HyprMenuAppGrid *self)
+{
+  cancel_search(self);
+  update_recent_visibility(self);
+  
+  if (!self->filter_key) {
+    g_ptr_array_set_size(self->search_levels, 0);
+    if (self->search_view) {
+      hyprmenu_search_view_set_results(HYPRMENU_SEARCH_VIEW(self->search_view), NULL, NULL, 0);
+    }
+    show_view(self, self->current_view);
+    return;
+  }
+  
+  if (!self->search_view) {
+    self->search_view = g_object_ref_sink(hyprmenu_search_view_new());
+  }
+  
+  /* Backspacing pops back to the level of a prefix of the new query */
+  SearchLevel *top = NULL;
+  while (self->search_levels->len > 0) {
+    top = g_ptr_array_index(self->search_levels, self->search_levels->len - 1);
+    if (g_str_has_prefix(self->filter_key, top->query)) {
+      break;
+    }
+    g_ptr_array_set_size(self->search_levels, self->search_levels->len - 1);
+    top = NULL;
+  }
+  
+  if (top && strcmp(top->query, self->filter_key) == 0) {
+    show_search_level(self, top);
+    return;
+  }
+  
+  GPtrArray *candidates = search_candidates(self, top);
+  
+  if (candidates->len < HYPRMENU_SEARCH_PARALLEL_MIN) {
+    show_search_level(self, push_search_level(self, hyprmenu_search_rank(candidates, self->filter_key)));
+  } else {
+    /* The current results stay up until the workers are done */
+    self->search_cancellable = g_cancellable_new();
+    hyprmenu_search_rank_async(candidates, self->filter_key, self->search_cancellable,
+                               on_search_ranked, self);
+  }
+  
+  g_ptr_array_unref(candidates);
+}
+
+static void start_catalog_update (HyprMenuAppGrid *self);
+
+static gboolean
+on_update_timeout(gpointer user_data)
+{
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  
+  self->update_source_id = 0;
+  start_catalog_update(self);
+  return G_SOURCE_REMOVE;
+}
+
+/* Package managers touch many files at once; wait for the burst to settle */
+static void
+schedule_catalog_update(HyprMenuAppGrid *self)
+{
+  if (self->update_source_id) {
+    g_source_remove(self->update_source_id);
+  }
+  self->update_source_id = g_timeout_add(250, on_update_timeout, self);
+}
+
+static void
+on_app_info_changed(GAppInfoMonitor *monitor, gpointer user_data)
+{
+  (void)monitor;
+  
+  schedule_catalog_update(HYPRMENU_APP_GRID(user_data));
+}
+
+static void
+on_app_dir_changed(GFileMonitor *monitor,
+                   GFile *file,
+                   GFile *other_file,
+                   GFileMonitorEvent event_type,
+                   gpointer user_data)
+{
+  (void)monitor;
+  (void)file;
+  (void)other_file;
+  
+  switch (event_type) {
+    case G_FILE_MONITOR_EVENT_CHANGES_DONE_HINT:
+    case G_FILE_MONITOR_EVENT_DELETED:
+    case G_FILE_MONITOR_EVENT_CREATED:
+    case G_FILE_MONITOR_EVENT_MOVED_IN:
+    case G_FILE_MONITOR_EVENT_MOVED_OUT:
+    case G_FILE_MONITOR_EVENT_RENAMED:
+      schedule_catalog_update(HYPRMENU_APP_GRID(user_data));
+      break;
+    default:
+      break;
+  }
+}
+
+static void
+free_dir_monitor(gpointer data)
+{
+  GFileMonitor *monitor = G_FILE_MONITOR(data);
+  
+  g_signal_handlers_disconnect_matched(monitor, G_SIGNAL_MATCH_FUNC, 0, 0, NULL,
+                                       on_app_dir_changed, NULL);
+  g_file_monitor_cancel(monitor);
+  g_object_unref(monitor);
+}
+
+/* Watch exactly the directories the current catalog was built from */
+static void
+update_dir_monitors(HyprMenuAppGrid *self)
+{
+  GPtrArray *dirs = hyprmenu_app_catalog_get_directories(self->catalog);
+  GHashTable *wanted = g_hash_table_new(g_str_hash, g_str_equal);
+  
+  for (guint i = 0; i < dirs->len; i++) {
+    const char *path = g_ptr_array_index(dirs, i);
+    g_hash_table_add(wanted, (gpointer)path);
+    
+    if (g_hash_table_contains(self->dir_monitors, path)) {
+      continue;
+    }
+    
+    GFile *dir = g_file_new_for_path(path);
+    GError *error = NULL;
+    GFileMonitor *monitor = g_file_monitor_directory(dir, G_FILE_MONITOR_WATCH_MOVES, NULL, &error);
+    g_object_unref(dir);
+    
+    if (!monitor) {
+      g_warning("Failed to watch %s: %s", path, error->message);
+      g_error_free(error);
+      continue;
+    }
+    
+    g_signal_connect(monitor, "changed", G_CALLBACK(on_app_dir_changed), self);
+    g_hash_table_insert(self->dir_monitors, g_strdup(path), monitor);
+  }
+  
+  GHashTableIter iter;
+  gpointer key;
+  g_hash_table_iter_init(&iter, self->dir_monitors);
+  while (g_hash_table_iter_next(&iter, &key, NULL)) {
+    if (!g_hash_table_contains(wanted, key)) {
+      g_hash_table_iter_remove(&iter);
+    }
+  }
+  
+  g_hash_table_destroy(wanted);
+  g_ptr_array_unref(dirs);
+}
+
+static void
+add_app(HyprMenuAppGrid *self, const HyprMenuCatalogEntry *app)
+{
+  HyprMenuAppItem *item = hyprmenu_app_item_new(app);
+  if (!item) return;
+  
+  /* Both views follow the store's items-changed signal; the store stays
+   * in name order */
+  g_hash_table_insert(self->items_by_id, (gpointer)hyprmenu_app_item_get_id(item), item);
+  g_list_store_insert_sorted(self->apps, item, hyprmenu_app_item_compare_by_name, NULL);
+  g_object_unref(item);
+}
+
+/* Append apps that sort after everything in the store with a single
+ * store change, so each view re-sorts and relayouts once per batch
+ * rather than once per app */
+static void
+append_apps(HyprMenuAppGrid *self, GPtrArray *items)
+{
+  for (guint i = 0; i < items->len; i++) {
+    HyprMenuAppItem *item = g_ptr_array_index(items, i);
+    g_hash_table_insert(self->items_by_id, (gpointer)hyprmenu_app_item_get_id(item), item);
+  }
+  
+  g_list_store_splice(self->apps, g_list_model_get_n_items(G_LIST_MODEL(self->apps)), 0,
+                      items->pdata, items->len);
+}
+
+static void
+remove_app(HyprMenuAppGrid *self, const char *app_id)
+{
+  HyprMenuAppItem *item = g_hash_table_lookup(self->items_by_id, app_id);
+  guint position;
+  
+  if (item && g_list_store_find(self->apps, item, &position)) {
+    g_hash_table_remove(self->items_by_id, app_id);
+    g_list_store_remove(self->apps, position);
+  }
+}
+
+static void
+replace_app(HyprMenuAppGrid *self, const HyprMenuCatalogEntry *app)
+{
+  HyprMenuAppItem *old_item = g_hash_table_lookup(self->items_by_id, app->id);
+  HyprMenuAppItem *new_item = hyprmenu_app_item_new(app);
+  guint position;
+  
+  if (!new_item) {
+    remove_app(self, app->id);
+    return;
+  }
+  
+  /* Replace the key too: it is borrowed from the item, and the old item
+   * may be freed below */
+  g_hash_table_replace(self->items_by_id, (gpointer)hyprmenu_app_item_get_id(new_item), new_item);
+  
+  /* A renamed app moves to its new place in name order */
+  if (old_item && g_list_store_find(self->apps, old_item, &position) &&
+      strcmp(hyprmenu_app_item_get_sort_key(old_item), hyprmenu_app_item_get_sort_key(new_item)) == 0) {
+    g_list_store_splice(self->apps, position, 1, (gpointer *)&new_item, 1);
+  } else {
+    if (old_item && g_list_store_find(self->apps, old_item, &position)) {
+      g_list_store_remove(self->apps, position);
+    }
+    g_list_store_insert_sorted(self->apps, new_item, hyprmenu_app_item_compare_by_name, NULL);
+  }
+  g_object_unref(new_item);
+}
+
+static void
+cancel_catalog_load(HyprMenuAppGrid *self)
+{
+  if (self->load_cancellable) {
+    g_cancellable_cancel(self->load_cancellable);
+    g_clear_object(&self->load_cancellable);
+  }
+  
+  if (self->populate_source_id) {
+    g_source_remove(self->populate_source_id);
+    self->populate_source_id = 0;
+  }
+}
+
+/* Returns FALSE if the load was cancelled, in which case user_data may
+ * already be gone and must not be touched */
+static gboolean
+finish_catalog_load(GAsyncResult *result, HyprMenuAppCatalog **catalog)
+{
+  GError *error = NULL;
+  
+  *catalog = hyprmenu_app_catalog_load_finish(result, &error);
+  if (*catalog) {
+    return TRUE;
+  }
+  
+  if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_error_free(error);
+    return FALSE;
+  }
+  
+  g_warning("Failed to load applications: %s", error->message);
+  g_error_free(error);
+  return TRUE;
+}
+
+static gboolean
+populate_batch(gpointer user_data)
+{
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  guint n_apps = hyprmenu_app_catalog_get_n_entries(self->catalog);
+  gint64 deadline = g_get_monotonic_time() + POPULATE_BATCH_BUDGET_US;
+  GPtrArray *batch = g_ptr_array_new_with_free_func(g_object_unref);
+  
+  /* The catalog hands entries out in name order, so each batch goes at
+   * the end of the store */
+  while (self->populate_index < n_apps) {
+    HyprMenuAppItem *item = hyprmenu_app_item_new(hyprmenu_app_catalog_get_entry(self->catalog, self->populate_index++));
+    if (item) {
+      g_ptr_array_add(batch, item);
+    }
+    if (g_get_monotonic_time() >= deadline) {
+      break;
+    }
+  }
+  
+  append_apps(self, batch);
+  g_ptr_array_unref(batch);
+  
+  /* Rank the new rows into an active search */
+  if (self->filter_key) {
+    update_search_results(self);
+  }
+  
+  if (self->populate_index < n_apps) {
+    return G_SOURCE_CONTINUE;
+  }
+  
+  g_print("hyprmenu_app_grid_refresh: Added %u apps\n", n_apps);
+  self->populate_source_id = 0;
+  update_dir_monitors(self);
+  update_recent_apps(self);
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_full_load_done(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+  (void)source;
+  
+  HyprMenuAppCatalog *catalog;
+  if (!finish_catalog_load(result, &catalog)) {
+    return;
+  }
+  
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  g_clear_object(&self->load_cancellable);
+  
+  if (!catalog) {
+    self->stale = TRUE;
+    return;
+  }
+  
+  self->catalog = catalog;
+  self->populate_index = 0;
+  
+  /* Idle priority runs below GTK's layout and paint, so a frame is drawn
+   * between batches */
+  self->populate_source_id = g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, populate_batch, self, NULL);
+}
+
+/* Patch only the rows whose desktop entries were added, removed or changed */
+static void
+on_update_load_done(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+  (void)source;
+  
+  HyprMenuAppCatalog *new_catalog;
+  if (!finish_catalog_load(result, &new_catalog)) {
+    return;
+  }
+  
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID(user_data);
+  g_clear_object(&self->load_cancellable);
+  
+  if (!new_catalog) {
+    return;
+  }
+  
+  HyprMenuAppCatalog *old_catalog = self->catalog;
+  guint n_old = hyprmenu_app_catalog_get_n_entries(old_catalog);
+  guint n_new = hyprmenu_app_catalog_get_n_entries(new_catalog);
+  guint removed = 0, added = 0, changed = 0;
+  
+  for (guint i = 0; i < n_old; i++) {
+    const HyprMenuCatalogEntry *old_app = hyprmenu_app_catalog_get_entry(old_catalog, i);
+    const HyprMenuCatalogEntry *new_app = hyprmenu_app_catalog_lookup(new_catalog, old_app->id);
+    
+    if (!new_app) {
+      remove_app(self, old_app->id);
+      removed++;
+    } else if (!hyprmenu_catalog_entry_equal(old_app, new_app)) {
+      replace_app(self, new_app);
+      changed++;
+    }
+  }
+  
+  for (guint i = 0; i < n_new; i++) {
+    const HyprMenuCatalogEntry *new_app = hyprmenu_app_catalog_get_entry(new_catalog, i);
+    
+    if (!hyprmenu_app_catalog_lookup(old_catalog, new_app->id)) {
+      add_app(self, new_app);
+      added++;
+    }
+  }
+  
+  self->catalog = new_catalog;
+  hyprmenu_app_catalog_free(old_catalog);
+  update_dir_monitors(self);
+  update_recent_apps(self);
+  
+  g_print("Applications updated: %u added, %u removed, %u changed\n", added, removed, changed);
+  
+  if ((added || removed || changed) && self->filter_key) {
+    update_search_results(self);
+  }
+}
+
+static void
+start_catalog_update (HyprMenuAppGrid *self)
+{
+  if (self->stale || !self->catalog) {
+    /* Nothing displayed yet; the next show does a full refresh */
+    return;
+  }
+  
+  if (self->load_cancellable || self->populate_source_id) {
+    /* Still loading; look again once that settles */
+    schedule_catalog_update(self);
+    return;
+  }
+  
+  self->load_cancellable = g_cancellable_new();
+  hyprmenu_app_catalog_load_async(self->load_cancellable, on_update_load_done, self);
+}
+
+/* The views are created on first use and then kept alive by the grid
+ * while swapped out. Both bind the shared store, so a view created late
+ * shows whatever has been loaded so far and keeps up from there. */
+static GtkWidget *
+ensure_category_list (HyprMenuAppGrid *self)
+{
+  if (self->category_list) {
+    return self->category_list;
+  }
+  
+  self->category_list = g_object_ref_sink (GTK_WIDGET (hyprmenu_category_list_new ()));
+  gtk_widget_set_hexpand (self->category_list, FALSE);
+  gtk_widget_set_vexpand (self->category_list, TRUE);
+  hyprmenu_category_list_set_grid_view (HYPRMENU_CATEGORY_LIST (self->category_list), TRUE);
+  hyprmenu_category_list_set_model (HYPRMENU_CATEGORY_LIST (self->category_list), G_LIST_MODEL (self->apps));
+  
+  return self->category_list;
+}
+
+static GtkWidget *
+ensure_list_view (HyprMenuAppGrid *self)
+{
+  if (self->list_view) {
+    return self->list_view;
+  }
+  
+  self->list_view = g_object_ref_sink (hyprmenu_list_view_new ());
+  hyprmenu_list_view_set_model (HYPRMENU_LIST_VIEW (self->list_view), G_LIST_MODEL (self->apps));
+  
+  return self->list_view;
+}
+
+static void
+hyprmenu_app_grid_dispose (GObject *object)
+{
+  HyprMenuAppGrid *self = HYPRMENU_APP_GRID (object);
+  
+  g_clear_object (&self->category_list);
+  g_clear_object (&self->list_view);
+  g_clear_object (&self->search_view);
+  cancel_search (self);
+  
+  G_OBJECT_CLASS (hyprmenu_app_grid_parent_class)->dispose (object);
+}
+
 static void
 hyprmenu_app_grid_finalize (GObject *object)
 {
   HyprMenuAppGrid *self = HYPRMENU_APP_GRID (object);
   
-  g_free (self->filter_text);
+  if (self->update_source_id) {
+    g_source_remove (self->update_source_id);
+    self->update_source_id = 0;
+  }
   
-  if (self->app_entries) {
-    for (guint i = 0; i < self->app_entries->len; i++) {
-      HyprMenuAppEntry *entry = g_array_index(self->app_entries, HyprMenuAppEntry*, i);
-      if (entry) {
-        g_object_unref(entry);
-      }
-    }
-    g_array_unref (self->app_entries);
+  cancel_catalog_load (self);
+  
+  if (self->app_monitor) {
+    g_signal_handlers_disconnect_by_data (self->app_monitor, self);
+    g_clear_object (&self->app_monitor);
   }
   
+  g_clear_pointer (&self->dir_monitors, g_hash_table_unref);
+  g_clear_pointer (&self->catalog, hyprmenu_app_catalog_free);
+  g_free (self->filter_text);
+  g_free (self->filter_key);
+  
+  g_clear_pointer (&self->search_levels, g_ptr_array_unref);
+  g_clear_pointer (&self->search_index, hyprmenu_search_index_free);
+  g_clear_pointer (&self->items_by_id, g_hash_table_unref);
+  g_signal_handlers_disconnect_by_data (self->apps, self);
+  g_clear_object (&self->apps);
+  
   G_OBJECT_CLASS (hyprmenu_app_grid_parent_class)->finalize (object);
 }
 
@@ -112,9 +796,27 @@ static void
 hyprmenu_app_grid_init (HyprMenuAppGrid *self)
 {
   /* Initialize data */
-  self->app_entries = g_array_new (FALSE, FALSE, sizeof (HyprMenuAppEntry *));
-  g_array_set_clear_func (self->app_entries, (GDestroyNotify) g_object_unref);
+  self->apps = g_list_store_new (HYPRMENU_TYPE_APP_ITEM);
+  self->items_by_id = g_hash_table_new (g_str_hash, g_str_equal);
   self->filter_text = NULL;
+  self->filter_key = NULL;
+  self->search_index = NULL;
+  self->search_levels = g_ptr_array_new_with_free_func (search_level_free);
+  self->search_cancellable = NULL;
+  g_signal_connect (self->apps, "items-changed", G_CALLBACK (on_apps_changed), self);
+  self->search_view = NULL;
+  self->shown_view = NULL;
+  self->catalog = NULL;
+  self->stale = TRUE;
+  self->load_cancellable = NULL;
+  self->populate_source_id = 0;
+  self->populate_index = 0;
+  self->dir_monitors = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, free_dir_monitor);
+  
+  /* GAppInfoMonitor covers changes other GIO users notice; the directory
+   * monitors are set up once the catalog knows which directories exist */
+  self->app_monitor = g_app_info_monitor_get ();
+  g_signal_connect (self->app_monitor, "changed", G_CALLBACK (on_app_info_changed), self);
   
   /* Create UI */
   gtk_orientable_set_orientation (GTK_ORIENTABLE (self), GTK_ORIENTATION_VERTICAL);
@@ -137,33 +839,35 @@ hyprmenu_app_grid_init (HyprMenuAppGrid *self)
           config->grid_hexpand ? "view-list-symbolic" : "view-grid-symbolic",
           config->grid_hexpand ? "grid" : "list");
   
-  /* Create scrolled window */
-  self->scrolled_window = gtk_scrolled_window_new ();
-  gtk_widget_set_vexpand (self->scrolled_window, TRUE);
-  gtk_widget_set_hexpand(self->scrolled_window, FALSE);
-  gtk_widget_set_halign(self->scrolled_window, GTK_ALIGN_CENTER);
-  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (self->scrolled_window),
-                                 GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
-  
-  /* Create both views */
-  self->category_list = GTK_WIDGET(hyprmenu_category_list_new());
-  gtk_widget_set_hexpand(self->category_list, FALSE);
-  gtk_widget_set_halign(self->category_list, GTK_ALIGN_CENTER);
-  self->list_view = hyprmenu_list_view_new();
-  
-  /* Set initial view based on config */
+  /* Container for the views. The views are GtkGridView and GtkListView,
+   * which must sit directly in their own scrolled windows to only build
+   * rows that are on screen. The stack is not homogeneous so only the
+   * shown view is measured. */
+  self->view_stack = gtk_stack_new ();
+  gtk_stack_set_hhomogeneous (GTK_STACK (self->view_stack), FALSE);
+  gtk_stack_set_vhomogeneous (GTK_STACK (self->view_stack), FALSE);
+  gtk_widget_set_vexpand (self->view_stack, TRUE);
+  
+  /* Only build the view that is shown; the other one is created on the
+   * first toggle */
   if (config->grid_hexpand) {
-    self->current_view = self->category_list;
-    hyprmenu_category_list_set_grid_view(HYPRMENU_CATEGORY_LIST(self->category_list), TRUE);
+    self->current_view = ensure_category_list (self);
   } else {
-    self->current_view = self->list_view;
+    self->current_view = ensure_list_view (self);
   }
   
-  gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(self->scrolled_window), 
-                               self->current_view);
+  show_view (self, self->current_view);
+  
+  /* Recently and frequently launched apps, filled once apps are loaded */
+  self->recent_box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, config->grid_column_spacing);
+  gtk_widget_add_css_class (self->recent_box, "hyprmenu-recent-apps");
+  gtk_widget_set_halign (self->recent_box, GTK_ALIGN_CENTER);
+  gtk_widget_set_margin_top (self->recent_box, config->grid_margin_top);
+  gtk_widget_set_visible (self->recent_box, FALSE);
+  gtk_box_append (GTK_BOX (self), self->recent_box);
   
-  /* Add scrolled window to self */
-  gtk_box_append(GTK_BOX(self), self->scrolled_window);
+  /* Add view container to self */
+  gtk_box_append (GTK_BOX (self), self->view_stack);
   
   // Add key controller for Super key
   self->key_controller = gtk_event_controller_key_new();
@@ -182,6 +886,7 @@ hyprmenu_app_grid_class_init (HyprMenuAppGridClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
   
+  object_class->dispose = hyprmenu_app_grid_dispose;
   object_class->finalize = hyprmenu_app_grid_finalize;
 }
 
@@ -201,72 +906,59 @@ hyprmenu_app_grid_refresh (HyprMenuAppGrid *self)
     return;
   }
   
-  /* Clear existing entries */
-  if (self->app_entries) {
-    for (guint i = 0; i < self->app_entries->len; i++) {
-      HyprMenuAppEntry *entry = g_array_index(self->app_entries, HyprMenuAppEntry*, i);
-      if (entry) {
-        g_object_unref(entry);
-      }
-    }
-    g_array_unref(self->app_entries);
-  }
+  /* Drop any load or insertion still in progress */
+  cancel_catalog_load(self);
   
-  /* Create a new array */
-  self->app_entries = g_array_new(FALSE, FALSE, sizeof(HyprMenuAppEntry *));
-  g_array_set_clear_func(self->app_entries, (GDestroyNotify)g_object_unref);
+  /* Clear the model; both views drop their rows with it */
+  g_hash_table_remove_all(self->items_by_id);
+  g_list_store_remove_all(self->apps);
+  if (self->filter_key) {
+    update_search_results(self);
+  }
   
-  /* Clear both views */
-  hyprmenu_category_list_clear(HYPRMENU_CATEGORY_LIST(self->category_list));
-  hyprmenu_list_view_clear(HYPRMENU_LIST_VIEW(self->list_view));
+  /* Load the desktop entries on a worker thread, from the on-disk catalog
+   * cache when it is still valid. Rows are inserted in batches once it
+   * arrives, so the window can be presented right away. */
+  g_clear_pointer(&self->catalog, hyprmenu_app_catalog_free);
+  self->stale = FALSE;
+  self->load_cancellable = g_cancellable_new();
+  hyprmenu_app_catalog_load_async(self->load_cancellable, on_full_load_done, self);
+}
+
+void
+hyprmenu_app_grid_ensure_fresh (HyprMenuAppGrid *self)
+{
+  g_return_if_fail(HYPRMENU_IS_APP_GRID(self));
   
-  /* Get all desktop apps */
-  GList *all_apps = g_app_info_get_all();
+  if (self->stale || (!self->catalog && !self->load_cancellable)) {
+    hyprmenu_app_grid_refresh(self);
+    return;
+  }
   
-  for (GList *l = all_apps; l != NULL; l = l->next) {
-    GAppInfo *app_info = G_APP_INFO(l->data);
-    
-    if (!G_IS_DESKTOP_APP_INFO(app_info) || !g_app_info_should_show(app_info)) {
-      continue;
-    }
-    
-    const char *app_name = g_app_info_get_name(app_info);
-    const char *app_id = g_app_info_get_id(app_info);
-    
-    if (!app_name || !app_id || app_name[0] == '\0' || app_id[0] == '\0') {
-      continue;
-    }
-    
-    /* Create app entry for the array */
-    HyprMenuAppEntry *entry = hyprmenu_app_entry_new(G_DESKTOP_APP_INFO(app_info));
-    if (!entry) continue;
-    
-    /* Add to both views */
-    gboolean category_added = hyprmenu_category_list_add_app(
-      HYPRMENU_CATEGORY_LIST(self->category_list), 
-      G_DESKTOP_APP_INFO(app_info)
-    );
-    
-    gboolean list_added = hyprmenu_list_view_add_app(
-      HYPRMENU_LIST_VIEW(self->list_view), 
-      G_DESKTOP_APP_INFO(app_info)
-    );
-    
-    if (!category_added || !list_added) {
-      g_warning("Failed to add app to one or both views: %s", app_id);
-      g_object_unref(entry);
-      continue;
-    }
-    
-    /* Store in array */
-    g_array_append_val(self->app_entries, entry);
+  if (self->load_cancellable || self->populate_source_id) {
+    /* Already loading */
+    return;
   }
   
-  g_list_free(all_apps);
+  /* Launch scores decay, and launches since the last show count now */
+  guint n_apps = g_list_model_get_n_items(G_LIST_MODEL(self->apps));
+  for (guint i = 0; i < n_apps; i++) {
+    HyprMenuAppItem *item = g_list_model_get_item(G_LIST_MODEL(self->apps), i);
+    hyprmenu_app_item_update_search_boost(item);
+    g_object_unref(item);
+  }
+  g_ptr_array_set_size(self->search_levels, 0);
+  update_recent_apps(self);
   
-  /* Apply current filter if any */
-  if (self->filter_text) {
-    hyprmenu_app_grid_filter(self, self->filter_text);
+  /* Catch changes whose notification is still pending or was missed;
+   * revalidating costs one stat() per application directory and
+   * desktop file */
+  if (self->update_source_id || !hyprmenu_app_catalog_is_current(self->catalog)) {
+    if (self->update_source_id) {
+      g_source_remove(self->update_source_id);
+      self->update_source_id = 0;
+    }
+    start_catalog_update(self);
   }
 }
 
@@ -278,20 +970,23 @@ hyprmenu_app_grid_filter (HyprMenuAppGrid *self, const char *search_text)
   g_free(self->filter_text);
   self->filter_text = g_strdup(search_text);
   
-  /* Apply filter to both views */
-  gboolean category_filtered = hyprmenu_category_list_filter(
-    HYPRMENU_CATEGORY_LIST(self->category_list), 
-    search_text
-  );
+  /* Fold the query once for the whole ranking pass */
+  g_free(self->filter_key);
+  self->filter_key = search_text && *search_text ? hyprmenu_search_fold(search_text) : NULL;
   
-  gboolean list_filtered = hyprmenu_list_view_filter(
-    HYPRMENU_LIST_VIEW(self->list_view), 
-    search_text
-  );
+  update_search_results(self);
+}
+
+gboolean
+hyprmenu_app_grid_launch_first_result (HyprMenuAppGrid *self)
+{
+  g_return_val_if_fail(HYPRMENU_IS_APP_GRID(self), FALSE);
   
-  if (!category_filtered || !list_filtered) {
-    g_warning("Failed to apply filter to one or both views");
+  if (!self->filter_key || !self->search_view) {
+    return FALSE;
   }
+  
+  return hyprmenu_search_view_launch_first(HYPRMENU_SEARCH_VIEW(self->search_view));
 }
 
 void
@@ -299,56 +994,29 @@ hyprmenu_app_grid_toggle_view (HyprMenuAppGrid *self)
 {
   g_return_if_fail(HYPRMENU_IS_APP_GRID(self));
   
-  gboolean old_mode = config->grid_hexpand;
-  
   g_print("Toggle view button clicked - changing from %s to %s\n", 
-          old_mode ? "grid" : "list", 
-          !old_mode ? "grid" : "list");
+          config->grid_hexpand ? "grid" : "list", 
+          !config->grid_hexpand ? "grid" : "list");
   
-  /* Update config */
   config->grid_hexpand = !config->grid_hexpand;
   
-  g_print("Config updated: grid_hexpand now = %s\n", config->grid_hexpand ? "true" : "false");
-  
-  /* Save configuration immediately */
-  GError *error = NULL;
-  gboolean saved = hyprmenu_config_save_with_error(&error);
-  if (!saved) {
-    g_warning("Failed to save configuration: %s", error ? error->message : "Unknown error");
-    g_clear_error(&error);
-  } else {
-    g_print("Configuration saved successfully with view mode: %s\n", 
-            config->grid_hexpand ? "grid" : "list");
-    
-    // Make absolutely sure changes are written to disk
-    fsync(0);  // Use fsync on stdout instead of sync()
-  }
-  
-  /* Verify the config value was actually changed */
-  g_print("Double-checking config->grid_hexpand = %s\n", config->grid_hexpand ? "true" : "false");
-  
   /* Update toggle button */
   gtk_button_set_icon_name(GTK_BUTTON(self->toggle_button),
                           config->grid_hexpand ? "view-list-symbolic" : "view-grid-symbolic");
   gtk_widget_set_tooltip_text(self->toggle_button,
                              config->grid_hexpand ? "Switch to List View" : "Switch to Grid View");
   
-  /* Switch views */
+  /* Switch views, building the other one the first time it is selected */
   GtkWidget *new_view;
   if (config->grid_hexpand) {
     g_print("Setting view to grid\n");
-    new_view = self->category_list;
-    hyprmenu_category_list_set_grid_view(HYPRMENU_CATEGORY_LIST(self->category_list), TRUE);
+    new_view = ensure_category_list(self);
   } else {
     // Validate list view before switching
-    if (!hyprmenu_list_view_is_valid(HYPRMENU_LIST_VIEW(self->list_view))) {
+    if (!hyprmenu_list_view_is_valid(HYPRMENU_LIST_VIEW(ensure_list_view(self)))) {
       g_warning("List view is not valid, falling back to grid view");
       config->grid_hexpand = TRUE;
-      new_view = self->category_list;
-      hyprmenu_category_list_set_grid_view(HYPRMENU_CATEGORY_LIST(self->category_list), TRUE);
-      
-      // Save the config again if we had to revert
-      hyprmenu_config_save();
+      new_view = ensure_category_list(self);
     } else {
       g_print("Setting view to list\n");
       new_view = self->list_view;
@@ -357,18 +1025,79 @@ hyprmenu_app_grid_toggle_view (HyprMenuAppGrid *self)
   
   if (new_view != self->current_view) {
     g_print("Switching current view\n");
-    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(self->scrolled_window), new_view);
     self->current_view = new_view;
     
-    /* Apply current filter to new view */
-    if (self->filter_text) {
-      hyprmenu_app_grid_filter(self, self->filter_text);
+    /* While searching the results stay up; the new view shows afterwards */
+    if (!self->filter_key) {
+      show_view(self, new_view);
     }
   } else {
     g_print("View didn't change (new_view == current_view)\n");
   }
+  
+  /* Persist the view mode without blocking the toggle on disk I/O */
+  hyprmenu_config_mark_dirty();
 }
 
 GtkWidget* hyprmenu_app_grid_get_toggle_button(HyprMenuAppGrid *self) {
   return self->toggle_button;
-} 
\ No newline at end of file
+} 
+
+/* Drop a built view so it is created again from the current config */
+static void
+drop_view(HyprMenuAppGrid *self, GtkWidget **view)
+{
+  if (!*view) {
+    return;
+  }
+  
+  if (*view == self->shown_view) {
+    self->shown_view = NULL;
+  }
+  if (gtk_widget_get_parent(*view)) {
+    gtk_stack_remove(GTK_STACK(self->view_stack), *view);
+  }
+  g_clear_object(view);
+}
+
+void
+hyprmenu_app_grid_apply_config (HyprMenuAppGrid *self, HyprMenuConfigSection changed)
+{
+  g_return_if_fail(HYPRMENU_IS_APP_GRID(self));
+  
+  /* Rows read their sizes and spacing when they are set up, so only
+   * views whose sections changed are rebuilt; both share the app store */
+  if (changed & (HYPRMENU_CONFIG_GRID | HYPRMENU_CONFIG_APP_ENTRY)) {
+    drop_view(self, &self->category_list);
+  }
+  if (changed & (HYPRMENU_CONFIG_LIST | HYPRMENU_CONFIG_APP_ENTRY | HYPRMENU_CONFIG_CATEGORY)) {
+    drop_view(self, &self->list_view);
+  }
+  if (changed & (HYPRMENU_CONFIG_LIST | HYPRMENU_CONFIG_APP_ENTRY)) {
+    drop_view(self, &self->search_view);
+  }
+  
+  /* The view mode is part of the grid section */
+  if (changed & HYPRMENU_CONFIG_GRID) {
+    gtk_button_set_icon_name(GTK_BUTTON(self->toggle_button),
+                            config->grid_hexpand ? "view-list-symbolic" : "view-grid-symbolic");
+    gtk_widget_set_tooltip_text(self->toggle_button,
+                               config->grid_hexpand ? "Switch to List View" : "Switch to Grid View");
+  }
+  self->current_view = config->grid_hexpand ? ensure_category_list(self) : ensure_list_view(self);
+  
+  if (changed & (HYPRMENU_CONFIG_GRID | HYPRMENU_CONFIG_APP_ENTRY | HYPRMENU_CONFIG_BEHAVIOR)) {
+    update_recent_apps(self);
+  }
+  
+  if (self->filter_key) {
+    /* Results are cut to max_search_results when ranked, and a rebuilt
+     * results view starts out empty, so rank again */
+    if ((changed & HYPRMENU_CONFIG_BEHAVIOR) || !self->search_view) {
+      g_ptr_array_set_size(self->search_levels, 0);
+      update_search_results(self);
+    }
+  } else {
+    show_view(self, self->current_view);
+  }
+}
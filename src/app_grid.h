@@ -2,6 +2,7 @@
 
 #include <gtk/gtk.h>
 #include "list_view.h"
+#include "config.h"
 
 G_BEGIN_DECLS
 
@@ -10,8 +11,11 @@ G_DECLARE_FINAL_TYPE (HyprMenuAppGrid, hyprmenu_app_grid, HYPRMENU, APP_GRID, Gt
 
 HyprMenuAppGrid* hyprmenu_app_grid_new (void);
 void hyprmenu_app_grid_refresh (HyprMenuAppGrid *self);
+void hyprmenu_app_grid_ensure_fresh (HyprMenuAppGrid *self);
 void hyprmenu_app_grid_filter (HyprMenuAppGrid *self, const char *search_text);
+gboolean hyprmenu_app_grid_launch_first_result (HyprMenuAppGrid *self);
 void hyprmenu_app_grid_toggle_view (HyprMenuAppGrid *self);
 GtkWidget* hyprmenu_app_grid_get_toggle_button(HyprMenuAppGrid *self);
+void hyprmenu_app_grid_apply_config (HyprMenuAppGrid *self, HyprMenuConfigSection changed);
 
 G_END_DECLS 
\ No newline at end of file
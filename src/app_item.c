@@ -0,0 +1,402 @@
+#include "app_item.h"
+#include "search.h"
+#include "launch_history.h"
+#include <gio/gdesktopappinfo.h>
+#include <string.h>
+
+struct _HyprMenuAppItem
+{
+  GObject parent_instance;
+
+  /* GRefString from g_ref_string_new_intern(), released in finalize.
+   * Items for the same app share storage while both are alive, and
+   * strings no item uses any more are freed with the last item. */
+  char *id;
+  char *name;
+  char *generic_name;
+  char *description;
+  char *keywords;
+  char *category;
+  char *exec;
+  char *desktop_file;
+
+  /* Folded with hyprmenu_search_fold() for matching, also GRefString */
+  char *name_key;
+  char *generic_name_key;
+  char *keywords_key;
+  char *exec_key;
+  char *description_key;
+  char *sort_key;              /* g_utf8_collate_key() of the name, GRefString */
+  guint64 search_mask;         /* hyprmenu_search_mask() of all the keys */
+  gint search_boost;           /* Frecency bonus; atomic, read by ranking workers */
+
+  GIcon *icon;
+};
+
+enum {
+  PROP_0,
+  PROP_ID,
+  PROP_NAME,
+  PROP_CATEGORY,
+  N_PROPS
+};
+
+static GParamSpec *properties[N_PROPS];
+
+G_DEFINE_TYPE (HyprMenuAppItem, hyprmenu_app_item, G_TYPE_OBJECT)
+
+static void
+hyprmenu_app_item_finalize (GObject *object)
+{
+  HyprMenuAppItem *self = HYPRMENU_APP_ITEM (object);
+
+  g_clear_object (&self->icon);
+  g_clear_pointer (&self->id, g_ref_string_release);
+  g_clear_pointer (&self->name, g_ref_string_release);
+  g_clear_pointer (&self->generic_name, g_ref_string_release);
+  g_clear_pointer (&self->description, g_ref_string_release);
+  g_clear_pointer (&self->keywords, g_ref_string_release);
+  g_clear_pointer (&self->category, g_ref_string_release);
+  g_clear_pointer (&self->exec, g_ref_string_release);
+  g_clear_pointer (&self->desktop_file, g_ref_string_release);
+  g_clear_pointer (&self->name_key, g_ref_string_release);
+  g_clear_pointer (&self->generic_name_key, g_ref_string_release);
+  g_clear_pointer (&self->keywords_key, g_ref_string_release);
+  g_clear_pointer (&self->exec_key, g_ref_string_release);
+  g_clear_pointer (&self->description_key, g_ref_string_release);
+  g_clear_pointer (&self->sort_key, g_ref_string_release);
+
+  G_OBJECT_CLASS (hyprmenu_app_item_parent_class)->finalize (object);
+}
+
+static void
+hyprmenu_app_item_get_property (GObject    *object,
+                                guint       prop_id,
+                                GValue     *value,
+                                GParamSpec *pspec)
+{
+  HyprMenuAppItem *self = HYPRMENU_APP_ITEM (object);
+
+  switch (prop_id) {
+    case PROP_ID:
+      g_value_set_string (value, self->id);
+      break;
+    case PROP_NAME:
+      g_value_set_string (value, self->name);
+      break;
+    case PROP_CATEGORY:
+      g_value_set_string (value, self->category);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+hyprmenu_app_item_init (HyprMenuAppItem *self)
+{
+  (void)self;
+}
+
+static void
+hyprmenu_app_item_class_init (HyprMenuAppItemClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = hyprmenu_app_item_finalize;
+  object_class->get_property = hyprmenu_app_item_get_property;
+
+  /* Read-only properties so views can sort and group with GtkExpressions */
+  properties[PROP_ID] = g_param_spec_string ("id", NULL, NULL, NULL,
+                                             G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+  properties[PROP_NAME] = g_param_spec_string ("name", NULL, NULL, NULL,
+                                               G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+  properties[PROP_CATEGORY] = g_param_spec_string ("category", NULL, NULL, NULL,
+                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, N_PROPS, properties);
+}
+
+static char *
+intern_or_null (const char *str)
+{
+  return str && *str ? g_ref_string_new_intern (str) : NULL;
+}
+
+static char *
+intern_folded (const char *str)
+{
+  char *folded = hyprmenu_search_fold (str);
+  char *interned = g_ref_string_new_intern (folded);
+  g_free (folded);
+  return interned;
+}
+
+/* Folded basename of the program an Exec line runs, so "ffx" style
+ * queries can find apps by their binary, e.g. /usr/bin/firefox %u */
+static char *
+exec_basename_key (const char *exec)
+{
+  if (!exec) {
+    return NULL;
+  }
+
+  const char *p = exec;
+  for (;;) {
+    while (*p == ' ' || *p == '"' || *p == '\'') p++;
+
+    gsize len = strcspn (p, " \"'");
+    if (len == 0) {
+      return NULL;
+    }
+
+    /* Skip "env VAR=value ..." wrappers */
+    if ((len == 3 && strncmp (p, "env", 3) == 0) || memchr (p, '=', len)) {
+      p += len;
+      continue;
+    }
+
+    const char *base = p;
+    for (const char *c = p; c < p + len; c++) {
+      if (*c == '/') base = c + 1;
+    }
+    if (base == p + len) {
+      return NULL;
+    }
+
+    char *program = g_strndup (base, p + len - base);
+    char *interned = intern_folded (program);
+    g_free (program);
+    return interned;
+  }
+}
+
+/* First entry of a ';'-separated Categories value */
+static char *
+primary_category (const char *categories)
+{
+  if (!categories || !*categories || !g_utf8_validate (categories, -1, NULL)) {
+    return g_ref_string_new_intern ("Other");
+  }
+
+  const char *end = strchr (categories, ';');
+  if (!end) {
+    return g_ref_string_new_intern (categories);
+  }
+  if (end == categories) {
+    return g_ref_string_new_intern ("Other");
+  }
+
+  char *first = g_strndup (categories, end - categories);
+  char *interned = g_ref_string_new_intern (first);
+  g_free (first);
+  return interned;
+}
+
+HyprMenuAppItem *
+hyprmenu_app_item_new (const HyprMenuCatalogEntry *entry)
+{
+  g_return_val_if_fail (entry != NULL, NULL);
+  g_return_val_if_fail (entry->id != NULL && entry->name != NULL, NULL);
+
+  HyprMenuAppItem *self = g_object_new (HYPRMENU_TYPE_APP_ITEM, NULL);
+
+  self->id = g_ref_string_new_intern (entry->id);
+  self->name = g_ref_string_new_intern (entry->name);
+  self->generic_name = intern_or_null (entry->generic_name);
+  self->description = intern_or_null (entry->comment);
+  self->keywords = intern_or_null (entry->keywords);
+  self->category = primary_category (entry->categories);
+  self->exec = intern_or_null (entry->exec);
+  self->desktop_file = intern_or_null (entry->filename);
+  self->icon = hyprmenu_catalog_icon_new (entry->icon);
+
+  char *sort_key = g_utf8_collate_key (self->name, -1);
+  self->sort_key = g_ref_string_new_intern (sort_key);
+  g_free (sort_key);
+
+  self->name_key = intern_folded (self->name);
+  self->generic_name_key = self->generic_name ? intern_folded (self->generic_name) : NULL;
+  self->keywords_key = self->keywords ? intern_folded (self->keywords) : NULL;
+  self->exec_key = exec_basename_key (self->exec);
+  self->description_key = self->description ? intern_folded (self->description) : NULL;
+  self->search_mask = hyprmenu_search_mask (self->name_key) |
+                      hyprmenu_search_mask (self->generic_name_key) |
+                      hyprmenu_search_mask (self->keywords_key) |
+                      hyprmenu_search_mask (self->exec_key) |
+                      hyprmenu_search_mask (self->description_key);
+  hyprmenu_app_item_update_search_boost (self);
+
+  return self;
+}
+
+const char *
+hyprmenu_app_item_get_id (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->id;
+}
+
+const char *
+hyprmenu_app_item_get_name (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->name;
+}
+
+const char *
+hyprmenu_app_item_get_generic_name (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->generic_name;
+}
+
+const char *
+hyprmenu_app_item_get_description (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->description;
+}
+
+const char *
+hyprmenu_app_item_get_keywords (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->keywords;
+}
+
+const char *
+hyprmenu_app_item_get_exec (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->exec;
+}
+
+const char *
+hyprmenu_app_item_get_desktop_file (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->desktop_file;
+}
+
+const char *
+hyprmenu_app_item_get_category (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->category;
+}
+
+const char *
+hyprmenu_app_item_get_name_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->name_key;
+}
+
+const char *
+hyprmenu_app_item_get_generic_name_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->generic_name_key;
+}
+
+const char *
+hyprmenu_app_item_get_keywords_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->keywords_key;
+}
+
+const char *
+hyprmenu_app_item_get_exec_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->exec_key;
+}
+
+const char *
+hyprmenu_app_item_get_description_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->description_key;
+}
+
+guint64
+hyprmenu_app_item_get_search_mask (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), 0);
+  return self->search_mask;
+}
+
+const char *
+hyprmenu_app_item_get_sort_key (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->sort_key;
+}
+
+int
+hyprmenu_app_item_compare_by_name (gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  const HyprMenuAppItem *item_a = a;
+  const HyprMenuAppItem *item_b = b;
+  (void)user_data;
+
+  int result = strcmp (item_a->sort_key, item_b->sort_key);
+  return result ? result : strcmp (item_a->id, item_b->id);
+}
+
+int
+hyprmenu_app_item_get_search_boost (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), 0);
+  return g_atomic_int_get (&self->search_boost);
+}
+
+void
+hyprmenu_app_item_update_search_boost (HyprMenuAppItem *self)
+{
+  g_return_if_fail (HYPRMENU_IS_APP_ITEM (self));
+
+  double score = hyprmenu_launch_history_get_score (hyprmenu_launch_history_get_default (), self->id);
+  g_atomic_int_set (&self->search_boost, hyprmenu_search_frecency_boost (score));
+}
+
+GIcon *
+hyprmenu_app_item_get_icon (HyprMenuAppItem *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), NULL);
+  return self->icon;
+}
+
+gboolean
+hyprmenu_app_item_launch (HyprMenuAppItem *self, GError **error)
+{
+  g_return_val_if_fail (HYPRMENU_IS_APP_ITEM (self), FALSE);
+
+  if (!self->desktop_file) {
+    g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                 "No desktop file for %s", self->id);
+    return FALSE;
+  }
+
+  GDesktopAppInfo *app_info = g_desktop_app_info_new_from_filename (self->desktop_file);
+  if (!app_info) {
+    g_set_error (error, G_IO_ERROR, G_IO_ERROR_FAILED,
+                 "Failed to load %s", self->desktop_file);
+    return FALSE;
+  }
+
+  g_print ("Launching app '%s' with command: %s\n", self->name,
+           self->exec ? self->exec : "(unknown)");
+
+  gboolean launched = g_app_info_launch (G_APP_INFO (app_info), NULL, NULL, error);
+  g_object_unref (app_info);
+
+  if (launched) {
+    hyprmenu_launch_history_record (hyprmenu_launch_history_get_default (), self->id);
+    hyprmenu_app_item_update_search_boost (self);
+  }
+  return launched;
+}
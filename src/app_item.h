@@ -0,0 +1,92 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include "app_catalog.h"
+
+G_BEGIN_DECLS
+
+#define HYPRMENU_TYPE_APP_ITEM (hyprmenu_app_item_get_type())
+G_DECLARE_FINAL_TYPE (HyprMenuAppItem, hyprmenu_app_item, HYPRMENU, APP_ITEM, GObject)
+
+/**
+ * Create the shared model object for one application. Strings are
+ * interned as GRefStrings, so items for the same app across catalog
+ * reloads share their storage and release it once none needs it, and
+ * the icon is created once for all views.
+ * @param entry The catalog entry to copy from
+ * @return A new item
+ */
+HyprMenuAppItem* hyprmenu_app_item_new (const HyprMenuCatalogEntry *entry);
+
+const char* hyprmenu_app_item_get_id (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_name (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_generic_name (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_description (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_keywords (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_exec (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_desktop_file (HyprMenuAppItem *self);
+
+/**
+ * Get the category the app is listed under: the first entry of its
+ * Categories key, or "Other"
+ */
+const char* hyprmenu_app_item_get_category (HyprMenuAppItem *self);
+
+/**
+ * Get the searchable fields folded with hyprmenu_search_fold(): name,
+ * GenericName, Keywords, the basename of the Exec program and Comment
+ * @return The key, owned by the item; NULL if the app lacks the field
+ *         (the name key is always set)
+ */
+const char* hyprmenu_app_item_get_name_key (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_generic_name_key (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_keywords_key (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_exec_key (HyprMenuAppItem *self);
+const char* hyprmenu_app_item_get_description_key (HyprMenuAppItem *self);
+
+/**
+ * Get the characters present in any of the search keys
+ * @return A mask as built by hyprmenu_search_mask()
+ */
+guint64 hyprmenu_app_item_get_search_mask (HyprMenuAppItem *self);
+
+/**
+ * Get the name's collation key, computed once when the item is created
+ * @return A key that sorts like the name under g_utf8_collate(), owned by the item
+ */
+const char* hyprmenu_app_item_get_sort_key (HyprMenuAppItem *self);
+
+/**
+ * Compare two items by name for sorting, a GCompareDataFunc. Compares
+ * the precomputed collation keys, with the desktop ID as a tie-breaker.
+ */
+int hyprmenu_app_item_compare_by_name (gconstpointer a, gconstpointer b, gpointer user_data);
+
+/**
+ * Get the ranking bonus earned by launching the app often and recently
+ * @return Points added to the app's search score
+ */
+int hyprmenu_app_item_get_search_boost (HyprMenuAppItem *self);
+
+/**
+ * Recompute the search boost from the launch history, which decays
+ * over time; launching the app through the item updates it already
+ */
+void hyprmenu_app_item_update_search_boost (HyprMenuAppItem *self);
+
+/**
+ * Get the app icon
+ * @return The icon (transfer none), or NULL if the app has none
+ */
+GIcon* hyprmenu_app_item_get_icon (HyprMenuAppItem *self);
+
+/**
+ * Launch the application and record the launch in the launch history.
+ * The full desktop entry is loaded from disk only at this point.
+ * @param self The item
+ * @param error Return location for an error
+ * @return TRUE if the app was launched
+ */
+gboolean hyprmenu_app_item_launch (HyprMenuAppItem *self, GError **error);
+
+G_END_DECLS
@@ -3,10 +3,37 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <glib/gstdio.h>
 
 // Global config instance
 HyprMenuConfig *config = NULL;
 
+/* Saving. The config is only written once something marked it dirty,
+ * after CONFIG_SAVE_DELAY_MS without further changes, on a worker
+ * thread. Writes are serialized and numbered so an older write still in
+ * flight never replaces a newer one. */
+#define CONFIG_SAVE_DELAY_MS 500
+
+static gboolean config_dirty = FALSE;   // Changed since last written
+static guint save_source_id = 0;        // Pending write-behind
+static gboolean save_in_flight = FALSE;
+static gboolean save_pending = FALSE;   // Save requested during a write
+static guint64 save_generation = 0;     // Last write handed out
+
+static GMutex write_mutex;
+static guint64 written_generation = 0;  // Under write_mutex
+static char *written_data = NULL;       // Under write_mutex, text on disk
+
+/* Reloading. Edits made on disk while a write is in flight are reloaded
+ * once it is done; edits made while changes of our own wait to be
+ * written are merged with them, key by key, against the values the file
+ * held before. */
+static gboolean reload_pending = FALSE;     // File changed during a write
+static HyprMenuConfig *synced = NULL;       // Values as last loaded or written
+static HyprMenuConfigReloadFunc reload_func = NULL;
+static gpointer reload_data = NULL;
+
 // Position mapping
 static const char* position_names[] = {
   "top-left",
@@ -63,159 +90,851 @@ hyprmenu_position_from_string(const gchar *position_str)
     return POSITION_TOP_LEFT;
 }
 
+/* Small helpers for hashing fields into a fingerprint (64-bit FNV-1a) */
+#define HASH_INIT G_GUINT64_CONSTANT(0xcbf29ce484222325)
+
+static guint64
+hash_bytes(guint64 hash, const void *data, gsize len)
+{
+  const guchar *bytes = data;
+  
+  for (gsize i = 0; i < len; i++) {
+    hash ^= bytes[i];
+    hash *= G_GUINT64_CONSTANT(0x100000001b3);
+  }
+  return hash;
+}
+
+static guint64
+hash_int(guint64 hash, int value)
+{
+  return hash_bytes(hash, &value, sizeof value);
+}
+
+static guint64
+hash_double(guint64 hash, double value)
+{
+  return hash_bytes(hash, &value, sizeof value);
+}
+
+static guint64
+hash_string(guint64 hash, const char *value)
+{
+  // Keep NULL apart from "" and every string apart from the next one
+  if (!value) {
+    return hash_int(hash, -1);
+  }
+  return hash_bytes(hash, value, strlen(value) + 1);
+}
+
+/* Files under the cache directory are written on a worker thread; a
+ * failed write only costs regenerating them next time */
+typedef struct {
+  char *path;
+  GBytes *bytes;
+} CacheWrite;
+
+static void
+cache_write_free(gpointer data)
+{
+  CacheWrite *write = data;
+  
+  g_free(write->path);
+  g_bytes_unref(write->bytes);
+  g_free(write);
+}
+
+static void
+cache_write_thread(GTask *task, gpointer source_object, gpointer task_data,
+                   GCancellable *cancellable)
+{
+  CacheWrite *write = task_data;
+  g_autofree char *dir = g_path_get_dirname(write->path);
+  gsize len;
+  const char *data = g_bytes_get_data(write->bytes, &len);
+  GError *error = NULL;
+  
+  (void)source_object;
+  (void)cancellable;
+  
+  g_mkdir_with_parents(dir, 0755);
+  if (!g_file_set_contents(write->path, data, len, &error)) {
+    g_warning("Failed to write cache file: %s", error->message);
+    g_error_free(error);
+  }
+  g_task_return_boolean(task, TRUE);
+}
+
+/**
+ * Write a cache file in the background
+ * @param path Path of the file, taken over
+ * @param bytes Contents, taken over
+ */
+static void
+write_cache_async(char *path, GBytes *bytes)
+{
+  CacheWrite *write = g_new0(CacheWrite, 1);
+  write->path = path;
+  write->bytes = bytes;
+  
+  GTask *task = g_task_new(NULL, NULL, NULL, NULL);
+  g_task_set_task_data(task, write, cache_write_free);
+  g_task_run_in_thread(task, cache_write_thread);
+  g_object_unref(task);
+}
+
+/* Config schema. Every key of the config file is described once here,
+ * and defaults, loading, validation, saving and freeing all walk the
+ * table. Keys naming the same field are read in table order, so a key
+ * overrides the ones before it. */
+typedef enum {
+  CONFIG_INT,
+  CONFIG_DOUBLE,
+  CONFIG_BOOL,
+  CONFIG_STRING,
+  CONFIG_POSITION
+} ConfigKeyType;
+
+typedef struct {
+  const char *group;
+  const char *key;
+  ConfigKeyType type;
+  gsize offset;            // Of the field in HyprMenuConfig
+  double def;              // Default of numbers, booleans and positions
+  const char *def_string;  // Default of strings
+  double min;              // Valid range of numbers
+  double max;
+  const char *comment;     // Written with the key; NULL for legacy keys, which are only read
+} ConfigKey;
+
+#define FIELD(field) G_STRUCT_OFFSET(HyprMenuConfig, field)
+
+#define INT_KEY(group, key, field, def, min, max, comment) \
+  { group, key, CONFIG_INT, FIELD(field), def, NULL, min, max, comment }
+#define DOUBLE_KEY(group, key, field, def, min, max, comment) \
+  { group, key, CONFIG_DOUBLE, FIELD(field), def, NULL, min, max, comment }
+#define BOOL_KEY(group, key, field, def, comment) \
+  { group, key, CONFIG_BOOL, FIELD(field), def, NULL, 0, 1, comment }
+#define STRING_KEY(group, key, field, def, comment) \
+  { group, key, CONFIG_STRING, FIELD(field), 0, def, 0, 0, comment }
+#define POSITION_KEY(group, key, field, def, comment) \
+  { group, key, CONFIG_POSITION, FIELD(field), def, NULL, 0, 0, comment }
+
+#define LEGACY_INT_KEY(group, key, field, def, min, max) \
+  INT_KEY(group, key, field, def, min, max, NULL)
+#define LEGACY_DOUBLE_KEY(group, key, field, def, min, max) \
+  DOUBLE_KEY(group, key, field, def, min, max, NULL)
+#define LEGACY_STRING_KEY(group, key, field, def) \
+  STRING_KEY(group, key, field, def, NULL)
+
+static const ConfigKey config_keys[] = {
+  // Style, replaced by Window and Border; read so old files keep working
+  LEGACY_DOUBLE_KEY("Style", "window_background_opacity", window_background_opacity, 1.0, 0.0, 1.0),
+  LEGACY_DOUBLE_KEY("Style", "window_background_blur", window_background_blur, 5.0, 0.0, G_MAXDOUBLE),
+  LEGACY_STRING_KEY("Style", "window_background_color", window_background_color, ""),
+  LEGACY_INT_KEY("Style", "inner_border_radius", inner_border_radius, 12, 0, G_MAXINT),
+  LEGACY_INT_KEY("Style", "inner_border_width", inner_border_width, 2, 0, G_MAXINT),
+  LEGACY_STRING_KEY("Style", "inner_border_color", inner_border_color, "#444444"),
+  LEGACY_STRING_KEY("Style", "window_shadow_color", window_shadow_color, "rgba(0,0,0,0.3)"),
+  LEGACY_INT_KEY("Style", "window_shadow_radius", window_shadow_radius, 20, 0, G_MAXINT),
+  LEGACY_STRING_KEY("Style", "window_halign", window_halign, "center"),
+  LEGACY_STRING_KEY("Style", "window_valign", window_valign, "center"),
+
+  // Layout
+  INT_KEY("Layout", "window_width", window_width, 800, 1, G_MAXINT,
+          "Width of the menu window in pixels"),
+  INT_KEY("Layout", "window_height", window_height, 600, 1, G_MAXINT,
+          "Height of the menu window in pixels"),
+  INT_KEY("Layout", "top_margin", top_margin, 48, G_MININT, G_MAXINT,
+          "Margin from the top of the screen"),
+  INT_KEY("Layout", "left_margin", left_margin, 8, G_MININT, G_MAXINT,
+          "Margin from the left of the screen"),
+  BOOL_KEY("Layout", "center_window", center_window, FALSE,
+           "Whether to center the window on screen"),
+  POSITION_KEY("Layout", "menu_position", menu_position, POSITION_TOP_LEFT,
+               "Position of the menu (top-left, top-center, top-right, bottom-left, bottom-center, bottom-right, center)"),
+  INT_KEY("Layout", "bottom_offset", bottom_offset, 55, G_MININT, G_MAXINT,
+          "Offset from bottom for dock/panel (0 to respect reserved space)"),
+  INT_KEY("Layout", "top_offset", top_offset, 48, G_MININT, G_MAXINT,
+          "Offset from top for panel"),
+  INT_KEY("Layout", "window_padding", window_padding, 8, 0, G_MAXINT,
+          "Internal padding of the main window"),
+
+  // Window
+  STRING_KEY("Window", "background_color", window_background_color, "",
+             "Window background color (empty for transparent)"),
+  DOUBLE_KEY("Window", "background_opacity", window_background_opacity, 1.0, 0.0, 1.0,
+             "Overall window opacity (0.0 to 1.0)"),
+  DOUBLE_KEY("Window", "background_blur", window_background_blur, 5.0, 0.0, G_MAXDOUBLE,
+             "Background blur strength"),
+  INT_KEY("Window", "corner_radius", window_corner_radius, 0, 0, G_MAXINT,
+          "Window corner radius"),
+  STRING_KEY("Window", "halign", window_halign, "center",
+             "Horizontal alignment (start, center, end)"),
+  STRING_KEY("Window", "valign", window_valign, "center",
+             "Vertical alignment (start, center, end)"),
+  STRING_KEY("Window", "shadow_color", window_shadow_color, "rgba(0,0,0,0.3)",
+             "Window shadow color"),
+  INT_KEY("Window", "shadow_radius", window_shadow_radius, 20, 0, G_MAXINT,
+          "Window shadow radius"),
+  DOUBLE_KEY("Window", "opacity", opacity, 1.0, 0.0, 1.0,
+             "Overall window opacity"),
+
+  // Border
+  STRING_KEY("Border", "inner_border_color", inner_border_color, "#444444",
+             "Color of the inner border"),
+  INT_KEY("Border", "inner_border_radius", inner_border_radius, 12, 0, G_MAXINT,
+          "Radius of inner border corners"),
+  INT_KEY("Border", "inner_border_width", inner_border_width, 2, 0, G_MAXINT,
+          "Width of inner border"),
+  STRING_KEY("Border", "outer_border_color", outer_border_color, "#888888",
+             "Color of the outer border"),
+  INT_KEY("Border", "outer_border_radius", outer_border_radius, 16, 0, G_MAXINT,
+          "Radius of outer border corners"),
+  INT_KEY("Border", "outer_border_width", outer_border_width, 3, 0, G_MAXINT,
+          "Width of outer border"),
+
+  // Grid
+  INT_KEY("Grid", "columns", grid_columns, 5, 1, G_MAXINT,
+          "Number of columns in grid"),
+  INT_KEY("Grid", "item_size", grid_item_size, 100, 1, G_MAXINT,
+          "Size of each grid item"),
+  INT_KEY("Grid", "item_corner_radius", grid_item_corner_radius, 8, 0, G_MAXINT,
+          "Corner radius of grid items"),
+  INT_KEY("Grid", "item_border_width", grid_item_border_width, 1, 0, G_MAXINT,
+          "Border width of grid items"),
+  STRING_KEY("Grid", "item_border_color", grid_item_border_color, "rgba(255,255,255,0.08)",
+             "Border color of grid items"),
+  STRING_KEY("Grid", "item_background_color", grid_item_background_color, "rgba(50,50,60,0.7)",
+             "Background color of grid items"),
+  INT_KEY("Grid", "row_spacing", grid_row_spacing, 12, 0, G_MAXINT,
+          "Vertical spacing between rows"),
+  INT_KEY("Grid", "column_spacing", grid_column_spacing, 12, 0, G_MAXINT,
+          "Horizontal spacing between columns"),
+  INT_KEY("Grid", "margin_start", grid_margin_start, 12, 0, G_MAXINT,
+          "Left margin"),
+  INT_KEY("Grid", "margin_end", grid_margin_end, 12, 0, G_MAXINT,
+          "Right margin"),
+  INT_KEY("Grid", "margin_top", grid_margin_top, 12, 0, G_MAXINT,
+          "Top margin"),
+  INT_KEY("Grid", "margin_bottom", grid_margin_bottom, 12, 0, G_MAXINT,
+          "Bottom margin"),
+  STRING_KEY("Grid", "halign", grid_halign, "center",
+             "Horizontal alignment of grid"),
+  STRING_KEY("Grid", "valign", grid_valign, "center",
+             "Vertical alignment of grid"),
+  BOOL_KEY("Grid", "hexpand", grid_hexpand, TRUE,
+           "Whether grid expands horizontally"),
+  BOOL_KEY("Grid", "vexpand", grid_vexpand, FALSE,
+           "Whether grid expands vertically"),
+  DOUBLE_KEY("Grid", "opacity", grid_opacity, 1.0, 0.0, 1.0,
+             "Overall grid opacity"),
+  DOUBLE_KEY("Grid", "item_opacity", grid_item_opacity, 1.0, 0.0, 1.0,
+             "Individual item opacity"),
+
+  // List
+  INT_KEY("List", "item_size", list_item_size, 48, 1, G_MAXINT,
+          "Height of each list item"),
+  INT_KEY("List", "item_corner_radius", list_item_corner_radius, 6, 0, G_MAXINT,
+          "Corner radius of list items"),
+  INT_KEY("List", "item_border_width", list_item_border_width, 1, 0, G_MAXINT,
+          "Border width of list items"),
+  STRING_KEY("List", "item_border_color", list_item_border_color, "rgba(255,255,255,0.05)",
+             "Border color of list items"),
+  STRING_KEY("List", "item_background_color", list_item_background_color, "rgba(60,60,70,0.6)",
+             "Background color of list items"),
+  INT_KEY("List", "row_spacing", list_row_spacing, 8, 0, G_MAXINT,
+          "Vertical spacing between items"),
+  INT_KEY("List", "margin_start", list_margin_start, 12, 0, G_MAXINT,
+          "Left margin"),
+  INT_KEY("List", "margin_end", list_margin_end, 12, 0, G_MAXINT,
+          "Right margin"),
+  INT_KEY("List", "margin_top", list_margin_top, 12, 0, G_MAXINT,
+          "Top margin"),
+  INT_KEY("List", "margin_bottom", list_margin_bottom, 12, 0, G_MAXINT,
+          "Bottom margin"),
+  STRING_KEY("List", "halign", list_halign, "fill",
+             "Horizontal alignment of list"),
+  STRING_KEY("List", "valign", list_valign, "center",
+             "Vertical alignment of list"),
+  BOOL_KEY("List", "hexpand", list_hexpand, TRUE,
+           "Whether list expands horizontally"),
+  BOOL_KEY("List", "vexpand", list_vexpand, FALSE,
+           "Whether list expands vertically"),
+  DOUBLE_KEY("List", "opacity", list_opacity, 1.0, 0.0, 1.0,
+             "Overall list opacity"),
+  DOUBLE_KEY("List", "item_opacity", list_item_opacity, 1.0, 0.0, 1.0,
+             "Individual item opacity"),
+
+  // AppEntry
+  INT_KEY("AppEntry", "icon_size", app_icon_size, 32, 0, G_MAXINT,
+          "Size of application icons"),
+  INT_KEY("AppEntry", "icon_corner_radius", app_icon_corner_radius, 6, 0, G_MAXINT,
+          "Corner radius of icons"),
+  STRING_KEY("AppEntry", "icon_background_color", app_icon_background_color, "rgba(60,60,70,0.6)",
+             "Background color behind icons"),
+  INT_KEY("AppEntry", "name_font_size", app_name_font_size, 12, 1, G_MAXINT,
+          "Font size of application names"),
+  STRING_KEY("AppEntry", "name_color", app_name_color, "#ffffff",
+             "Color of application names"),
+  INT_KEY("AppEntry", "desc_font_size", app_desc_font_size, 10, 1, G_MAXINT,
+          "Font size of application descriptions"),
+  STRING_KEY("AppEntry", "desc_color", app_desc_color, "rgba(255,255,255,0.7)",
+             "Color of application descriptions"),
+  INT_KEY("AppEntry", "padding", app_entry_padding, 6, 0, G_MAXINT,
+          "Internal padding of entries"),
+  STRING_KEY("AppEntry", "hover_color", app_entry_hover_color, "rgba(100,100,100,0.8)",
+             "Background color on hover"),
+  STRING_KEY("AppEntry", "active_color", app_entry_active_color, "rgba(100,100,100,0.9)",
+             "Background color when clicked"),
+  DOUBLE_KEY("AppEntry", "opacity", app_entry_opacity, 1.0, 0.0, 1.0,
+             "Overall entry opacity"),
+  DOUBLE_KEY("AppEntry", "icon_opacity", app_icon_opacity, 1.0, 0.0, 1.0,
+             "Icon opacity"),
+  DOUBLE_KEY("AppEntry", "name_opacity", app_name_opacity, 1.0, 0.0, 1.0,
+             "Name text opacity"),
+  DOUBLE_KEY("AppEntry", "desc_opacity", app_desc_opacity, 1.0, 0.0, 1.0,
+             "Description text opacity"),
+
+  // Category
+  STRING_KEY("Category", "background_color", category_background_color, "#2d2d2d",
+             "Category background color"),
+  DOUBLE_KEY("Category", "background_opacity", category_background_opacity, 1.0, 0.0, 1.0,
+             "Category background opacity"),
+  INT_KEY("Category", "corner_radius", category_corner_radius, 10, 0, G_MAXINT,
+          "Corner radius of category headers"),
+  STRING_KEY("Category", "text_color", category_text_color, "",
+             "Category text color"),
+  INT_KEY("Category", "font_size", category_font_size, 13, 1, G_MAXINT,
+          "Category text size"),
+  STRING_KEY("Category", "font_family", category_font_family, "Sans Bold",
+             "Category font family"),
+  INT_KEY("Category", "padding", category_padding, 6, 0, G_MAXINT,
+          "Internal padding of categories"),
+  BOOL_KEY("Category", "show_separators", category_show_separators, TRUE,
+           "Whether to show separators between categories"),
+  STRING_KEY("Category", "separator_color", category_separator_color, "rgba(255,255,255,0.1)",
+             "Color of category separators"),
+  DOUBLE_KEY("Category", "opacity", category_opacity, 1.0, 0.0, 1.0,
+             "Overall category opacity"),
+  DOUBLE_KEY("Category", "title_opacity", category_title_opacity, 1.0, 0.0, 1.0,
+             "Category title opacity"),
+
+  // Search
+  STRING_KEY("Search", "background_color", search_background_color, "rgba(34, 34, 34, 0.3)",
+             "Search bar background color"),
+  DOUBLE_KEY("Search", "background_opacity", search_background_opacity, 1.0, 0.0, 1.0,
+             "Search bar background opacity"),
+  INT_KEY("Search", "corner_radius", search_corner_radius, 8, 0, G_MAXINT,
+          "Corner radius of search bar"),
+  STRING_KEY("Search", "text_color", search_text_color, "",
+             "Search text color"),
+  INT_KEY("Search", "font_size", search_font_size, 14, 1, G_MAXINT,
+          "Search text size"),
+  STRING_KEY("Search", "font_family", search_font_family, "Sans",
+             "Search text font"),
+  INT_KEY("Search", "padding", search_padding, 8, 0, G_MAXINT,
+          "Internal padding of search bar"),
+  INT_KEY("Search", "min_height", search_min_height, 20, 0, G_MAXINT,
+          "Minimum height of search bar"),
+  INT_KEY("Search", "left_padding", search_left_padding, 2, 0, G_MAXINT,
+          "Left padding of search text"),
+  INT_KEY("Search", "length", search_length, 0, 0, G_MAXINT,
+          "Maximum search text length (0 for unlimited)"),
+  STRING_KEY("Search", "placeholder_text", search_placeholder_text, "Search applications...",
+             "Placeholder text when empty"),
+  INT_KEY("Search", "icon_size", search_icon_size, 16, 0, G_MAXINT,
+          "Size of search icon"),
+  STRING_KEY("Search", "icon_color", search_icon_color, "rgba(255,255,255,0.7)",
+             "Color of search icon"),
+  STRING_KEY("Search", "focus_border_color", search_focus_border_color, "rgba(255,255,255,0.2)",
+             "Border color when focused"),
+  STRING_KEY("Search", "focus_shadow_color", search_focus_shadow_color, "rgba(0,0,0,0.1)",
+             "Shadow color when focused"),
+  DOUBLE_KEY("Search", "opacity", search_opacity, 1.0, 0.0, 1.0,
+             "Overall search bar opacity"),
+  DOUBLE_KEY("Search", "text_opacity", search_text_opacity, 1.0, 0.0, 1.0,
+             "Search text opacity"),
+  DOUBLE_KEY("Search", "icon_opacity", search_icon_opacity, 1.0, 0.0, 1.0,
+             "Search icon opacity"),
+
+  // SystemButton
+  STRING_KEY("SystemButton", "background_color", system_button_background_color, "rgba(60,60,70,0.6)",
+             "Button background color"),
+  STRING_KEY("SystemButton", "icon_color", system_button_icon_color, "rgba(255,255,255,0.7)",
+             "Button icon color"),
+  STRING_KEY("SystemButton", "hover_color", system_button_hover_color, "rgba(100,100,100,0.8)",
+             "Background color on hover"),
+  STRING_KEY("SystemButton", "active_color", system_button_active_color, "rgba(100,100,100,0.9)",
+             "Background color when clicked"),
+  INT_KEY("SystemButton", "corner_radius", system_button_corner_radius, 6, 0, G_MAXINT,
+          "Corner radius of buttons"),
+  INT_KEY("SystemButton", "size", system_button_size, 32, 0, G_MAXINT,
+          "Size of buttons"),
+  INT_KEY("SystemButton", "spacing", system_button_spacing, 8, 0, G_MAXINT,
+          "Space between buttons"),
+  DOUBLE_KEY("SystemButton", "opacity", system_button_opacity, 1.0, 0.0, 1.0,
+             "Overall button opacity"),
+  DOUBLE_KEY("SystemButton", "icon_opacity", system_button_icon_opacity, 1.0, 0.0, 1.0,
+             "Button icon opacity"),
+
+  // Behavior
+  BOOL_KEY("Behavior", "close_on_click_outside", close_on_click_outside, TRUE,
+           "Close when clicking outside the menu"),
+  BOOL_KEY("Behavior", "close_on_super_key", close_on_super_key, TRUE,
+           "Close when pressing Super key"),
+  BOOL_KEY("Behavior", "close_on_app_launch", close_on_app_launch, TRUE,
+           "Close when launching an application"),
+  BOOL_KEY("Behavior", "focus_search_on_open", focus_search_on_open, TRUE,
+           "Focus search bar when opening"),
+  BOOL_KEY("Behavior", "close_on_escape", close_on_escape, TRUE,
+           "Close when pressing Escape"),
+  BOOL_KEY("Behavior", "close_on_focus_out", close_on_focus_out, TRUE,
+           "Close when losing focus"),
+  BOOL_KEY("Behavior", "show_categories", show_categories, TRUE,
+           "Show application categories"),
+  BOOL_KEY("Behavior", "show_descriptions", show_descriptions, TRUE,
+           "Show application descriptions"),
+  BOOL_KEY("Behavior", "show_icons", show_icons, TRUE,
+           "Show application icons"),
+  BOOL_KEY("Behavior", "show_search", show_search, TRUE,
+           "Show search bar"),
+  BOOL_KEY("Behavior", "show_scrollbar", show_scrollbar, TRUE,
+           "Show scrollbar"),
+  BOOL_KEY("Behavior", "show_border", show_border, TRUE,
+           "Show window border"),
+  BOOL_KEY("Behavior", "show_shadow", show_shadow, TRUE,
+           "Show window shadow"),
+  BOOL_KEY("Behavior", "blur_background", blur_background, TRUE,
+           "Enable background blur"),
+  INT_KEY("Behavior", "blur_strength", blur_strength, 10, 0, G_MAXINT,
+          "Background blur strength"),
+  LEGACY_DOUBLE_KEY("Behavior", "opacity", opacity, 1.0, 0.0, 1.0),
+  INT_KEY("Behavior", "max_recent_apps", max_recent_apps, 10, 1, G_MAXINT,
+          "Maximum number of recent apps to show"),
+  INT_KEY("Behavior", "max_search_results", max_search_results, 50, 1, G_MAXINT,
+          "Maximum number of search results to show"),
+
+  // Transparency
+  BOOL_KEY("Transparency", "enabled", blur_background, TRUE,
+           "Enable transparency effects"),
+  DOUBLE_KEY("Transparency", "alpha", opacity, 1.0, 0.0, 1.0,
+             "Global alpha value (0.0 to 1.0)"),
+  BOOL_KEY("Transparency", "blur", blur_background, TRUE,
+           "Enable blur effects"),
+  BOOL_KEY("Transparency", "shadow", show_shadow, TRUE,
+           "Enable shadow effects"),
+  STRING_KEY("Transparency", "shadow_color", window_shadow_color, "rgba(0,0,0,0.3)",
+             "Shadow color"),
+  INT_KEY("Transparency", "shadow_radius", window_shadow_radius, 20, 0, G_MAXINT,
+          "Shadow radius"),
+
+  // Hyprland
+  BOOL_KEY("Hyprland", "use_hyprland_corner_fix", use_hyprland_corner_fix, FALSE,
+           "Enable corner artifact fix for Hyprland"),
+  INT_KEY("Hyprland", "hyprland_corner_radius", hyprland_corner_radius, 0, 0, G_MAXINT,
+          "Corner radius to use with Hyprland fix"),
+};
+
+/* Key file groups in the order they are written, and the part of the
+ * menu they configure */
+static const struct {
+  const char *group;
+  const char *comment;
+  HyprMenuConfigSection section;
+} config_groups[] = {
+  { "Layout",       "# Main window dimensions and positioning",              HYPRMENU_CONFIG_LAYOUT },
+  { "Window",       "# Main window appearance",                              HYPRMENU_CONFIG_WINDOW },
+  { "Border",       "# Border appearance settings",                          HYPRMENU_CONFIG_WINDOW },
+  { "Grid",         "# Grid view settings (when showing apps in grid mode)", HYPRMENU_CONFIG_GRID },
+  { "List",         "# List view settings (when showing apps in list mode)", HYPRMENU_CONFIG_LIST },
+  { "AppEntry",     "# Individual application entry appearance",             HYPRMENU_CONFIG_APP_ENTRY },
+  { "Category",     "# Category header appearance",                          HYPRMENU_CONFIG_CATEGORY },
+  { "Search",       "# Search bar appearance and behavior",                  HYPRMENU_CONFIG_SEARCH },
+  { "SystemButton", "# System button appearance (power, settings, etc.)",    HYPRMENU_CONFIG_SYSTEM_BUTTON },
+  { "Behavior",     "# Program behavior settings",                           HYPRMENU_CONFIG_BEHAVIOR },
+  { "Transparency", "# Global transparency settings",                        HYPRMENU_CONFIG_WINDOW },
+  { "Hyprland",     "# Hyprland-specific settings",                          HYPRMENU_CONFIG_WINDOW },
+};
+
+static gpointer
+key_field(HyprMenuConfig *config, const ConfigKey *key)
+{
+  return G_STRUCT_MEMBER_P(config, key->offset);
+}
+
+/* Set every field to its default, leaving the file paths alone */
+static void
+apply_defaults(HyprMenuConfig *config)
+{
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    gpointer field = key_field(config, key);
+    
+    switch (key->type) {
+      case CONFIG_INT:
+      case CONFIG_BOOL:
+        *(int *)field = (int)key->def;
+        break;
+      case CONFIG_DOUBLE:
+        *(double *)field = key->def;
+        break;
+      case CONFIG_POSITION:
+        *(HyprMenuPosition *)field = (HyprMenuPosition)key->def;
+        break;
+      case CONFIG_STRING:
+        g_free(*(char **)field);
+        *(char **)field = g_strdup(key->def_string);
+        break;
+    }
+  }
+}
+
+static gboolean
+only_spaces(const char *text)
+{
+  while (g_ascii_isspace(*text)) text++;
+  return *text == '\0';
+}
+
+/* Validate a key file value and store it in its field
+ * @return FALSE, leaving the field alone, if the value is invalid */
+static gboolean
+parse_value(HyprMenuConfig *config, const ConfigKey *key, const char *value)
+{
+  gpointer field = key_field(config, key);
+  char *end = NULL;
+  
+  switch (key->type) {
+    case CONFIG_INT: {
+      gint64 number = g_ascii_strtoll(value, &end, 10);
+      if (end == value || !only_spaces(end) || number < key->min || number > key->max) {
+        return FALSE;
+      }
+      *(int *)field = (int)number;
+      return TRUE;
+    }
+    case CONFIG_DOUBLE: {
+      double number = g_ascii_strtod(value, &end);
+      // Written this way round so NaN fails too
+      if (end == value || !only_spaces(end) || !(number >= key->min && number <= key->max)) {
+        return FALSE;
+      }
+      *(double *)field = number;
+      return TRUE;
+    }
+    case CONFIG_BOOL:
+      if (g_ascii_strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+        *(gboolean *)field = TRUE;
+      } else if (g_ascii_strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+        *(gboolean *)field = FALSE;
+      } else {
+        return FALSE;
+      }
+      return TRUE;
+    case CONFIG_STRING:
+      g_free(*(char **)field);
+      *(char **)field = g_strdup(value);
+      return TRUE;
+    case CONFIG_POSITION:
+      *(HyprMenuPosition *)field = hyprmenu_position_from_string(value);
+      return TRUE;
+  }
+  
+  return FALSE;
+}
+
+/* Copy one keyed field, duplicating strings */
+static void
+copy_value(HyprMenuConfig *dest, HyprMenuConfig *src, const ConfigKey *key)
+{
+  gpointer to = key_field(dest, key);
+  gpointer from = key_field(src, key);
+  
+  switch (key->type) {
+    case CONFIG_INT:
+    case CONFIG_BOOL:
+      *(int *)to = *(int *)from;
+      break;
+    case CONFIG_DOUBLE:
+      *(double *)to = *(double *)from;
+      break;
+    case CONFIG_POSITION:
+      *(HyprMenuPosition *)to = *(HyprMenuPosition *)from;
+      break;
+    case CONFIG_STRING:
+      if (to != from) {
+        g_free(*(char **)to);
+        *(char **)to = g_strdup(*(char **)from);
+      }
+      break;
+  }
+}
+
+static gboolean
+value_equal(HyprMenuConfig *a, HyprMenuConfig *b, const ConfigKey *key)
+{
+  gpointer field_a = key_field(a, key);
+  gpointer field_b = key_field(b, key);
+  
+  switch (key->type) {
+    case CONFIG_INT:
+    case CONFIG_BOOL:
+      return *(int *)field_a == *(int *)field_b;
+    case CONFIG_DOUBLE:
+      return *(double *)field_a == *(double *)field_b;
+    case CONFIG_POSITION:
+      return *(HyprMenuPosition *)field_a == *(HyprMenuPosition *)field_b;
+    case CONFIG_STRING:
+      return g_strcmp0(*(char **)field_a, *(char **)field_b) == 0;
+  }
+  
+  return FALSE;
+}
+
+/* Copy of the keyed fields of the config; file paths are left out */
+static HyprMenuConfig *
+values_copy(void)
+{
+  HyprMenuConfig *values = g_new0(HyprMenuConfig, 1);
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    copy_value(values, config, &config_keys[i]);
+  }
+  return values;
+}
+
+static void
+values_free(HyprMenuConfig *values)
+{
+  if (!values) {
+    return;
+  }
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    if (config_keys[i].type == CONFIG_STRING) {
+      g_clear_pointer((char **)key_field(values, &config_keys[i]), g_free);
+    }
+  }
+  g_free(values);
+}
+
+/* Note that the config matches the file */
+static void
+set_synced(HyprMenuConfig *values)
+{
+  values_free(synced);
+  synced = values;
+}
+
+/* Binary snapshot of the parsed config in the cache directory. While the
+ * config file keeps its identity, mtime and size the snapshot is copied
+ * into the config instead of parsing the key file. Values follow the
+ * header in config_keys order, skipping legacy keys: int32 for integers,
+ * booleans and positions, doubles as is, and strings as an int32 length
+ * (G_MAXUINT32 for NULL) followed by their bytes. */
+#define CONFIG_SNAPSHOT_MAGIC "HMCONF\0\1"
+
+typedef struct {
+  char magic[8];
+  guint64 schema;  // schema_hash() of the table the snapshot was made with
+  guint64 device;  // Identity and state of the config file it was parsed from
+  guint64 inode;
+  gint64 mtime;
+  gint64 size;
+} ConfigSnapshotHeader;
+
+static char *
+snapshot_path(void)
+{
+  return g_build_filename(g_get_user_cache_dir(), "hyprmenu", "config.bin", NULL);
+}
+
+/* Fingerprint of config_keys, so snapshots made for another layout of
+ * the table or the struct are never read */
+static guint64
+schema_hash(void)
+{
+  guint64 hash = HASH_INIT;
+  
+  hash = hash_int(hash, (int)sizeof(HyprMenuConfig));
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    hash = hash_string(hash, key->group);
+    hash = hash_string(hash, key->key);
+    hash = hash_int(hash, key->type);
+    hash = hash_int(hash, (int)key->offset);
+    hash = hash_double(hash, key->min);
+    hash = hash_double(hash, key->max);
+  }
+  return hash;
+}
+
+static void
+snapshot_fill_header(ConfigSnapshotHeader *header, const GStatBuf *st)
+{
+  memset(header, 0, sizeof *header);
+  memcpy(header->magic, CONFIG_SNAPSHOT_MAGIC, sizeof header->magic);
+  header->schema = schema_hash();
+  header->device = st->st_dev;
+  header->inode = st->st_ino;
+  header->mtime = st->st_mtime;
+  header->size = st->st_size;
+}
+
+/* Walk the values of a snapshot, copying them into the config if apply
+ * is set
+ * @return FALSE if the snapshot is truncated or has trailing data */
+static gboolean
+snapshot_read_values(const guchar *data, gsize len, gboolean apply)
+{
+  gsize pos = sizeof(ConfigSnapshotHeader);
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    gpointer field = key_field(config, key);
+    gint32 number;
+    double real;
+    guint32 string_len;
+    
+    if (!key->comment) {
+      continue;
+    }
+    
+    switch (key->type) {
+      case CONFIG_INT:
+      case CONFIG_BOOL:
+      case CONFIG_POSITION:
+        if (len - pos < sizeof number) return FALSE;
+        memcpy(&number, data + pos, sizeof number);
+        pos += sizeof number;
+        if (apply && key->type == CONFIG_POSITION) {
+          *(HyprMenuPosition *)field = (HyprMenuPosition)number;
+        } else if (apply) {
+          *(int *)field = number;
+        }
+        break;
+      case CONFIG_DOUBLE:
+        if (len - pos < sizeof real) return FALSE;
+        memcpy(&real, data + pos, sizeof real);
+        pos += sizeof real;
+        if (apply) {
+          *(double *)field = real;
+        }
+        break;
+      case CONFIG_STRING:
+        if (len - pos < sizeof string_len) return FALSE;
+        memcpy(&string_len, data + pos, sizeof string_len);
+        pos += sizeof string_len;
+        if (string_len != G_MAXUINT32 && len - pos < string_len) return FALSE;
+        if (apply) {
+          g_free(*(char **)field);
+          *(char **)field = string_len == G_MAXUINT32 ? NULL :
+                            g_strndup((const char *)data + pos, string_len);
+        }
+        if (string_len != G_MAXUINT32) {
+          pos += string_len;
+        }
+        break;
+    }
+  }
+  
+  return pos == len;
+}
+
+/* Fill the config from a snapshot of the config file as it is now
+ * @return FALSE, leaving the config alone, if there is none */
+static gboolean
+load_snapshot(const GStatBuf *st)
+{
+  g_autofree char *path = snapshot_path();
+  g_autofree char *data = NULL;
+  gsize len = 0;
+  ConfigSnapshotHeader expected, header;
+  
+  if (!g_file_get_contents(path, &data, &len, NULL) || len < sizeof header) {
+    return FALSE;
+  }
+  
+  memcpy(&header, data, sizeof header);
+  snapshot_fill_header(&expected, st);
+  if (memcmp(&header, &expected, sizeof header) != 0) {
+    return FALSE;
+  }
+  
+  // Check the whole snapshot first so a bad one changes nothing
+  if (!snapshot_read_values((const guchar *)data, len, FALSE)) {
+    return FALSE;
+  }
+  snapshot_read_values((const guchar *)data, len, TRUE);
+  return TRUE;
+}
+
+/* Snapshot the config just parsed from the file described by st */
+static void
+save_snapshot(const GStatBuf *st)
+{
+  ConfigSnapshotHeader header;
+  
+  /* mtime has one second granularity. A file modified in the same second
+   * it was parsed could change again without its mtime moving, so don't
+   * snapshot it; the next start parses it again. */
+  if (st->st_mtime >= (gint64)(g_get_real_time() / G_USEC_PER_SEC) - 1) {
+    return;
+  }
+  
+  GByteArray *bytes = g_byte_array_new();
+  snapshot_fill_header(&header, st);
+  g_byte_array_append(bytes, (const guint8 *)&header, sizeof header);
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    gpointer field = key_field(config, key);
+    gint32 number;
+    guint32 string_len;
+    const char *string;
+    
+    if (!key->comment) {
+      continue;
+    }
+    
+    switch (key->type) {
+      case CONFIG_INT:
+      case CONFIG_BOOL:
+        number = *(int *)field;
+        g_byte_array_append(bytes, (const guint8 *)&number, sizeof number);
+        break;
+      case CONFIG_POSITION:
+        number = *(HyprMenuPosition *)field;
+        g_byte_array_append(bytes, (const guint8 *)&number, sizeof number);
+        break;
+      case CONFIG_DOUBLE:
+        g_byte_array_append(bytes, field, sizeof(double));
+        break;
+      case CONFIG_STRING:
+        string = *(char **)field;
+        string_len = string ? (guint32)strlen(string) : G_MAXUINT32;
+        g_byte_array_append(bytes, (const guint8 *)&string_len, sizeof string_len);
+        if (string) {
+          g_byte_array_append(bytes, (const guint8 *)string, string_len);
+        }
+        break;
+    }
+  }
+  
+  write_cache_async(snapshot_path(), g_byte_array_free_to_bytes(bytes));
+}
+
 // Default configuration
 static void
 set_defaults(HyprMenuConfig *config)
 {
-  // Window layout
-  config->window_width = 800;
-  config->window_height = 600;
-  config->top_margin = 48;
-  config->left_margin = 8;
-  config->center_window = FALSE;
-  config->menu_position = POSITION_TOP_LEFT;
-  config->bottom_offset = 55;
-  config->top_offset = 48;
-  config->window_padding = 8;
-  
-  // Window style
-  config->window_background_opacity = 1.0;
-  config->window_background_blur = 5.0;
-  config->window_background_color = g_strdup("");
-  config->inner_border_radius = 12;
-  config->inner_border_width = 2;
-  config->inner_border_color = g_strdup("#444444");
-  config->window_shadow_color = g_strdup("rgba(0,0,0,0.3)");
-  config->window_shadow_radius = 20;
-  config->window_halign = g_strdup("center");
-  config->window_valign = g_strdup("center");
-  
-  // Grid options
-  config->grid_margin_start = 12;
-  config->grid_margin_end = 12;
-  config->grid_margin_top = 12;
-  config->grid_margin_bottom = 12;
-  config->grid_row_spacing = 12;
-  config->grid_column_spacing = 12;
-  config->grid_halign = g_strdup("center");
-  config->grid_valign = g_strdup("center");
-  config->grid_hexpand = TRUE;
-  config->grid_vexpand = FALSE;
-  config->grid_columns = 5;
-  config->grid_item_size = 100;
-  config->grid_item_corner_radius = 8;
-  config->grid_item_border_width = 1;
-  config->grid_item_border_color = g_strdup("rgba(255,255,255,0.08)");
-  config->grid_item_background_color = g_strdup("rgba(50,50,60,0.7)");
-  config->grid_opacity = 1.0;
-  config->grid_item_opacity = 1.0;
-  
-  // List options
-  config->list_item_size = 48;
-  config->list_item_corner_radius = 6;
-  config->list_item_border_width = 1;
-  config->list_item_border_color = g_strdup("rgba(255,255,255,0.05)");
-  config->list_item_background_color = g_strdup("rgba(60,60,70,0.6)");
-  config->list_row_spacing = 8;
-  config->list_halign = g_strdup("fill");
-  config->list_valign = g_strdup("center");
-  config->list_hexpand = TRUE;
-  config->list_vexpand = FALSE;
-  config->list_margin_start = 12;
-  config->list_margin_end = 12;
-  config->list_margin_top = 12;
-  config->list_margin_bottom = 12;
-  config->list_opacity = 1.0;
-  config->list_item_opacity = 1.0;
-  
-  // AppEntry options
-  config->app_icon_size = 32;
-  config->app_icon_corner_radius = 6;
-  config->app_icon_background_color = g_strdup("rgba(60,60,70,0.6)");
-  config->app_name_font_size = 12;
-  config->app_name_color = g_strdup("#ffffff");
-  config->app_desc_font_size = 10;
-  config->app_desc_color = g_strdup("rgba(255,255,255,0.7)");
-  config->app_entry_padding = 6;
-  config->app_entry_hover_color = g_strdup("rgba(100,100,100,0.8)");
-  config->app_entry_active_color = g_strdup("rgba(100,100,100,0.9)");
-  config->app_entry_opacity = 1.0;
-  config->app_icon_opacity = 1.0;
-  config->app_name_opacity = 1.0;
-  config->app_desc_opacity = 1.0;
-  
-  // Category options
-  config->category_background_color = g_strdup("#2d2d2d");
-  config->category_background_opacity = 1.0;
-  config->category_corner_radius = 10;
-  config->category_text_color = g_strdup("");
-  config->category_font_size = 13;
-  config->category_font_family = g_strdup("Sans Bold");
-  config->category_padding = 6;
-  config->category_show_separators = TRUE;
-  config->category_separator_color = g_strdup("rgba(255,255,255,0.1)");
-  config->category_opacity = 1.0;
-  config->category_title_opacity = 1.0;
-  
-  // Search options
-  config->search_background_color = g_strdup("rgba(34, 34, 34, 0.3)");
-  config->search_background_opacity = 1.0;
-  config->search_corner_radius = 8;
-  config->search_text_color = g_strdup("");
-  config->search_font_size = 14;
-  config->search_font_family = g_strdup("Sans");
-  config->search_padding = 8;
-  config->search_min_height = 20;
-  config->search_left_padding = 2;
-  config->search_length = 0;
-  config->search_placeholder_text = g_strdup("Search applications...");
-  config->search_icon_size = 16;
-  config->search_icon_color = g_strdup("rgba(255,255,255,0.7)");
-  config->search_focus_border_color = g_strdup("rgba(255,255,255,0.2)");
-  config->search_focus_shadow_color = g_strdup("rgba(0,0,0,0.1)");
-  config->search_opacity = 1.0;
-  config->search_text_opacity = 1.0;
-  config->search_icon_opacity = 1.0;
-  
-  // SystemButton options
-  config->system_button_background_color = g_strdup("rgba(60,60,70,0.6)");
-  config->system_button_icon_color = g_strdup("rgba(255,255,255,0.7)");
-  config->system_button_hover_color = g_strdup("rgba(100,100,100,0.8)");
-  config->system_button_active_color = g_strdup("rgba(100,100,100,0.9)");
-  config->system_button_corner_radius = 6;
-  config->system_button_size = 32;
-  config->system_button_spacing = 8;
-  config->system_button_opacity = 1.0;
-  config->system_button_icon_opacity = 1.0;
-  
-  // Behavior options
-  config->close_on_click_outside = TRUE;
-  config->close_on_super_key = TRUE;
-  config->close_on_app_launch = TRUE;
-  config->focus_search_on_open = TRUE;  // Ensure this is TRUE
-  config->close_on_escape = TRUE;
-  config->close_on_focus_out = TRUE;
-  config->show_categories = TRUE;
-  config->show_descriptions = TRUE;
-  config->show_icons = TRUE;
-  config->show_search = TRUE;
-  config->show_scrollbar = TRUE;
-  config->show_border = TRUE;
-  config->show_shadow = TRUE;
-  config->blur_background = TRUE;
-  config->blur_strength = 10;
-  config->opacity = 1.0;
-  config->max_recent_apps = 10;  // Default to showing 10 recent apps
+  apply_defaults(config);
   
   // File paths
   config->config_dir = g_build_filename(g_get_home_dir(), ".config", "hyprmenu", NULL);
   config->config_file = g_build_filename(config->config_dir, "hyprmenu.conf", NULL);
   config->css_file = g_build_filename(config->config_dir, "hyprmenu.css", NULL);
-
-  // Outer border (window)
-  config->outer_border_width = 3;
-  config->outer_border_color = g_strdup("#888888");
-  config->outer_border_radius = 16;
 }
 
 gboolean
@@ -238,7 +957,7 @@ hyprmenu_config_init()
     hyprmenu_config_load();
   } else {
     // Save default configuration
-    hyprmenu_config_save();
+    hyprmenu_config_mark_dirty();
   }
   
   return TRUE;
@@ -252,55 +971,40 @@ hyprmenu_config_free()
   }
   
   // Free allocated strings
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    if (config_keys[i].type == CONFIG_STRING) {
+      g_clear_pointer((char **)key_field(config, &config_keys[i]), g_free);
+    }
+  }
   g_free(config->config_dir);
   g_free(config->config_file);
   g_free(config->css_file);
-  g_free(config->window_border_color);
-  g_free(config->window_background_color);
-  g_free(config->window_halign);
-  g_free(config->window_valign);
-  g_free(config->window_shadow_color);
-  g_free(config->inner_border_color);
-  g_free(config->outer_border_color);
-  g_free(config->grid_halign);
-  g_free(config->grid_valign);
-  g_free(config->grid_item_border_color);
-  g_free(config->grid_item_background_color);
-  g_free(config->list_item_border_color);
-  g_free(config->list_item_background_color);
-  g_free(config->list_halign);
-  g_free(config->list_valign);
-  g_free(config->app_icon_background_color);
-  g_free(config->app_name_color);
-  g_free(config->app_desc_color);
-  g_free(config->app_entry_hover_color);
-  g_free(config->app_entry_active_color);
-  g_free(config->category_background_color);
-  g_free(config->category_text_color);
-  g_free(config->category_font_family);
-  g_free(config->category_separator_color);
-  g_free(config->search_background_color);
-  g_free(config->search_text_color);
-  g_free(config->search_font_family);
-  g_free(config->search_placeholder_text);
-  g_free(config->search_icon_color);
-  g_free(config->search_focus_border_color);
-  g_free(config->search_focus_shadow_color);
-  g_free(config->system_button_background_color);
-  g_free(config->system_button_icon_color);
-  g_free(config->system_button_hover_color);
-  g_free(config->system_button_active_color);
+  g_clear_pointer(&synced, values_free);
   
   // Free the config struct itself
   g_free(config);
   config = NULL;
 }
 
-gboolean
-hyprmenu_config_load()
+/* Replace the config with the file's values */
+static gboolean
+load_file(void)
 {
   g_autoptr(GKeyFile) keyfile = g_key_file_new();
   gboolean missing_option = FALSE;
+  GStatBuf st;
+  
+  if (g_stat(config->config_file, &st) != 0) {
+    g_warning("Failed to load config file: %s", config->config_file);
+    return FALSE;
+  }
+  
+  // Unchanged since the last parse: take the parsed values as they were
+  if (load_snapshot(&st)) {
+    config_dirty = FALSE;
+    set_synced(values_copy());
+    return TRUE;
+  }
   
   // Load keyfile
   if (!g_key_file_load_from_file(keyfile, config->config_file, G_KEY_FILE_NONE, NULL)) {
@@ -308,733 +1012,493 @@ hyprmenu_config_load()
     return FALSE;
   }
   
-  // Window layout
-  if (g_key_file_has_group(keyfile, "Layout")) {
-    if (!g_key_file_has_key(keyfile, "Layout", "window_width", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "window_height", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "top_margin", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "left_margin", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "center_window", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "menu_position", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "bottom_offset", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "top_offset", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Layout", "window_padding", NULL)) missing_option = TRUE;
-    config->window_width = g_key_file_get_integer(keyfile, "Layout", "window_width", NULL);
-    config->window_height = g_key_file_get_integer(keyfile, "Layout", "window_height", NULL);
-    config->top_margin = g_key_file_get_integer(keyfile, "Layout", "top_margin", NULL);
-    config->left_margin = g_key_file_get_integer(keyfile, "Layout", "left_margin", NULL);
-    config->center_window = g_key_file_get_boolean(keyfile, "Layout", "center_window", NULL);
+  // Keys missing from the file keep their defaults
+  apply_defaults(config);
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    g_autofree char *value = g_key_file_get_string(keyfile, key->group, key->key, NULL);
     
-    // Load position setting
-    char *position_str = g_key_file_get_string(keyfile, "Layout", "menu_position", NULL);
-    if (position_str) {
-      config->menu_position = hyprmenu_position_from_string(position_str);
-      g_free(position_str);
+    if (!value) {
+      if (key->comment) {
+        missing_option = TRUE;
+      }
+      continue;
     }
     
-    // Load offsets
-    config->bottom_offset = g_key_file_get_integer(keyfile, "Layout", "bottom_offset", NULL);
-    config->top_offset = g_key_file_get_integer(keyfile, "Layout", "top_offset", NULL);
-    config->window_padding = g_key_file_get_integer(keyfile, "Layout", "window_padding", NULL);
+    if (!parse_value(config, key, value)) {
+      g_warning("Invalid value for %s.%s in config: %s", key->group, key->key, value);
+    }
   }
   
-  // Window style
-  if (g_key_file_has_group(keyfile, "Style")) {
-    if (!g_key_file_has_key(keyfile, "Style", "window_background_opacity", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_background_blur", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_background_color", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "inner_border_radius", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "inner_border_width", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "inner_border_color", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_shadow_color", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_shadow_radius", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_halign", NULL)) missing_option = TRUE;
-    if (!g_key_file_has_key(keyfile, "Style", "window_valign", NULL)) missing_option = TRUE;
-    config->window_background_opacity = g_key_file_get_double(keyfile, "Style", "window_background_opacity", NULL);
-    config->window_background_blur = g_key_file_get_double(keyfile, "Style", "window_background_blur", NULL);
-    g_free(config->window_background_color);
-    config->window_background_color = g_key_file_get_string(keyfile, "Style", "window_background_color", NULL);
-    config->inner_border_radius = g_key_file_get_integer(keyfile, "Style", "inner_border_radius", NULL);
-    config->inner_border_width = g_key_file_get_integer(keyfile, "Style", "inner_border_width", NULL);
-    g_free(config->inner_border_color);
-    config->inner_border_color = g_key_file_get_string(keyfile, "Style", "inner_border_color", NULL);
-    g_free(config->window_shadow_color);
-    config->window_shadow_color = g_key_file_get_string(keyfile, "Style", "window_shadow_color", NULL);
-    config->window_shadow_radius = g_key_file_get_integer(keyfile, "Style", "window_shadow_radius", NULL);
-    g_free(config->window_halign);
-    config->window_halign = g_key_file_get_string(keyfile, "Style", "window_halign", NULL);
-    g_free(config->window_valign);
-    config->window_valign = g_key_file_get_string(keyfile, "Style", "window_valign", NULL);
+  // The config now matches the file, unless options have to be added
+  config_dirty = FALSE;
+  set_synced(values_copy());
+  if (missing_option) {
+    hyprmenu_config_mark_dirty();
+  } else {
+    save_snapshot(&st);
   }
   
-  // Window section (modern format, takes precedence over Style section)
-  if (g_key_file_has_group(keyfile, "Window")) {
-    if (g_key_file_has_key(keyfile, "Window", "background_color", NULL)) {
-      g_free(config->window_background_color);
-      config->window_background_color = g_key_file_get_string(keyfile, "Window", "background_color", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "background_opacity", NULL)) {
-      config->window_background_opacity = g_key_file_get_double(keyfile, "Window", "background_opacity", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "background_blur", NULL)) {
-      config->window_background_blur = g_key_file_get_double(keyfile, "Window", "background_blur", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "corner_radius", NULL)) {
-      config->window_corner_radius = g_key_file_get_integer(keyfile, "Window", "corner_radius", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "halign", NULL)) {
-      g_free(config->window_halign);
-      config->window_halign = g_key_file_get_string(keyfile, "Window", "halign", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "valign", NULL)) {
-      g_free(config->window_valign);
-      config->window_valign = g_key_file_get_string(keyfile, "Window", "valign", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "shadow_color", NULL)) {
-      g_free(config->window_shadow_color);
-      config->window_shadow_color = g_key_file_get_string(keyfile, "Window", "shadow_color", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "shadow_radius", NULL)) {
-      config->window_shadow_radius = g_key_file_get_integer(keyfile, "Window", "shadow_radius", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Window", "opacity", NULL)) {
-      config->opacity = g_key_file_get_double(keyfile, "Window", "opacity", NULL);
-    }
+  return TRUE;
+}
+
+gboolean
+hyprmenu_config_load()
+{
+  // The file is older than the config until pending changes are written
+  if (config_dirty || save_in_flight) {
+    return TRUE;
   }
   
-  // Border section
-  if (g_key_file_has_group(keyfile, "Border")) {
-    if (g_key_file_has_key(keyfile, "Border", "inner_border_color", NULL)) {
-      g_free(config->inner_border_color);
-      config->inner_border_color = g_key_file_get_string(keyfile, "Border", "inner_border_color", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Border", "inner_border_radius", NULL)) {
-      config->inner_border_radius = g_key_file_get_integer(keyfile, "Border", "inner_border_radius", NULL);
+  return load_file();
+}
+
+/* Build a key file holding the config; must run on the main thread
+ * since the config is only ever changed there */
+static GKeyFile *
+config_to_keyfile(void)
+{
+  GKeyFile *keyfile = g_key_file_new();
+  
+  // Add header comments
+  g_key_file_set_comment(keyfile, NULL, NULL, 
+    "# HyprMenu Configuration File\n"
+    "# This file controls the appearance and behavior of HyprMenu\n"
+    "# All color values support #RRGGBB, #RRGGBBAA, rgb(), or rgba() formats\n"
+    "# Colors may also name the pywal palette: @color0 to @color15, @background,\n"
+    "# @foreground and @cursor follow ~/.cache/wal/colors.json while running", NULL);
+
+  for (gsize g = 0; g < G_N_ELEMENTS(config_groups); g++) {
+    const char *group = config_groups[g].group;
+    
+    for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+      const ConfigKey *key = &config_keys[i];
+      gpointer field = key_field(config, key);
+      
+      if (!key->comment || strcmp(key->group, group) != 0) {
+        continue;
+      }
+      
+      switch (key->type) {
+        case CONFIG_INT:
+          g_key_file_set_integer(keyfile, group, key->key, *(int *)field);
+          break;
+        case CONFIG_DOUBLE:
+          g_key_file_set_double(keyfile, group, key->key, *(double *)field);
+          break;
+        case CONFIG_BOOL:
+          g_key_file_set_boolean(keyfile, group, key->key, *(gboolean *)field);
+          break;
+        case CONFIG_STRING:
+          g_key_file_set_string(keyfile, group, key->key, *(char **)field ? *(char **)field : "");
+          break;
+        case CONFIG_POSITION:
+          g_key_file_set_string(keyfile, group, key->key,
+                                hyprmenu_position_to_string(*(HyprMenuPosition *)field));
+          break;
+      }
+      g_key_file_set_comment(keyfile, group, key->key, key->comment, NULL);
     }
-    if (g_key_file_has_key(keyfile, "Border", "inner_border_width", NULL)) {
-      config->inner_border_width = g_key_file_get_integer(keyfile, "Border", "inner_border_width", NULL);
+    
+    // A group only takes a comment once it has keys
+    g_key_file_set_comment(keyfile, group, NULL, config_groups[g].comment, NULL);
+  }
+
+  return keyfile;
+}
+
+/* Serialize the config as key file text */
+static char *
+config_to_data(GError **error)
+{
+  g_autoptr(GKeyFile) keyfile = config_to_keyfile();
+  
+  return g_key_file_to_data(keyfile, NULL, error);
+}
+
+/* Compare two key files built by config_to_keyfile(), which always hold
+ * the same keys, group by group */
+static HyprMenuConfigSection
+diff_sections(GKeyFile *before, GKeyFile *after)
+{
+  HyprMenuConfigSection changed = 0;
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_groups); i++) {
+    if (changed & config_groups[i].section) {
+      continue;
     }
-    if (g_key_file_has_key(keyfile, "Border", "outer_border_color", NULL)) {
-      g_free(config->outer_border_color);
-      config->outer_border_color = g_key_file_get_string(keyfile, "Border", "outer_border_color", NULL);
+    
+    g_auto(GStrv) keys = g_key_file_get_keys(after, config_groups[i].group, NULL, NULL);
+    for (gsize k = 0; keys && keys[k]; k++) {
+      g_autofree char *old_value = g_key_file_get_value(before, config_groups[i].group, keys[k], NULL);
+      g_autofree char *new_value = g_key_file_get_value(after, config_groups[i].group, keys[k], NULL);
+      if (g_strcmp0(old_value, new_value) != 0) {
+        changed |= config_groups[i].section;
+        break;
+      }
     }
-    if (g_key_file_has_key(keyfile, "Border", "outer_border_radius", NULL)) {
-      config->outer_border_radius = g_key_file_get_integer(keyfile, "Border", "outer_border_radius", NULL);
+  }
+  
+  return changed;
+}
+
+/* Write serialized config text, replacing the file atomically: the text
+ * goes to a temporary file which is synced and renamed over the config.
+ * Writes older than the last one, or of the text already on disk, are
+ * skipped. Safe to call from any thread. */
+static gboolean
+write_config(const char *path, const char *data, guint64 generation, GError **error)
+{
+  gboolean ok = TRUE;
+  
+  g_mutex_lock(&write_mutex);
+  if (generation > written_generation) {
+    if (g_strcmp0(data, written_data) != 0) {
+      ok = g_file_set_contents_full(path, data, -1, G_FILE_SET_CONTENTS_CONSISTENT,
+                                    0644, error);
+      if (ok) {
+        g_free(written_data);
+        written_data = g_strdup(data);
+      }
     }
-    if (g_key_file_has_key(keyfile, "Border", "outer_border_width", NULL)) {
-      config->outer_border_width = g_key_file_get_integer(keyfile, "Border", "outer_border_width", NULL);
+    if (ok) {
+      written_generation = generation;
     }
   }
+  g_mutex_unlock(&write_mutex);
   
-  // Grid options
-  if (g_key_file_has_group(keyfile, "Grid")) {
-    config->grid_margin_start = g_key_file_get_integer(keyfile, "Grid", "margin_start", NULL);
-    config->grid_margin_end = g_key_file_get_integer(keyfile, "Grid", "margin_end", NULL);
-    config->grid_margin_top = g_key_file_get_integer(keyfile, "Grid", "margin_top", NULL);
-    config->grid_margin_bottom = g_key_file_get_integer(keyfile, "Grid", "margin_bottom", NULL);
-    config->grid_row_spacing = g_key_file_get_integer(keyfile, "Grid", "row_spacing", NULL);
-    config->grid_column_spacing = g_key_file_get_integer(keyfile, "Grid", "column_spacing", NULL);
-    g_free(config->grid_halign);
-    config->grid_halign = g_key_file_get_string(keyfile, "Grid", "halign", NULL);
-    g_free(config->grid_valign);
-    config->grid_valign = g_key_file_get_string(keyfile, "Grid", "valign", NULL);
-    config->grid_hexpand = g_key_file_get_boolean(keyfile, "Grid", "hexpand", NULL);
-    config->grid_vexpand = g_key_file_get_boolean(keyfile, "Grid", "vexpand", NULL);
-    config->grid_columns = g_key_file_get_integer(keyfile, "Grid", "columns", NULL);
-    config->grid_item_size = g_key_file_get_integer(keyfile, "Grid", "item_size", NULL);
-    config->grid_item_corner_radius = g_key_file_get_integer(keyfile, "Grid", "item_corner_radius", NULL);
-    g_free(config->grid_item_border_color);
-    config->grid_item_border_color = g_key_file_get_string(keyfile, "Grid", "item_border_color", NULL);
-    g_free(config->grid_item_background_color);
-    config->grid_item_background_color = g_key_file_get_string(keyfile, "Grid", "item_background_color", NULL);
-  }
+  return ok;
+}
+
+gboolean
+hyprmenu_config_save_with_error(GError **error)
+{
+  GError *local_error = NULL;
   
-  // List options
-  if (g_key_file_has_group(keyfile, "List")) {
-    config->list_item_size = g_key_file_get_integer(keyfile, "List", "item_size", NULL);
-    config->list_item_corner_radius = g_key_file_get_integer(keyfile, "List", "item_corner_radius", NULL);
-    g_free(config->list_item_border_color);
-    config->list_item_border_color = g_key_file_get_string(keyfile, "List", "item_border_color", NULL);
-    g_free(config->list_item_background_color);
-    config->list_item_background_color = g_key_file_get_string(keyfile, "List", "item_background_color", NULL);
-    config->list_row_spacing = g_key_file_get_integer(keyfile, "List", "row_spacing", NULL);
-    g_free(config->list_halign);
-    config->list_halign = g_key_file_get_string(keyfile, "List", "halign", NULL);
-    g_free(config->list_valign);
-    config->list_valign = g_key_file_get_string(keyfile, "List", "valign", NULL);
-    config->list_hexpand = g_key_file_get_boolean(keyfile, "List", "hexpand", NULL);
-    config->list_vexpand = g_key_file_get_boolean(keyfile, "List", "vexpand", NULL);
-    config->list_margin_start = g_key_file_get_integer(keyfile, "List", "margin_start", NULL);
-    config->list_margin_end = g_key_file_get_integer(keyfile, "List", "margin_end", NULL);
-    config->list_margin_top = g_key_file_get_integer(keyfile, "List", "margin_top", NULL);
-    config->list_margin_bottom = g_key_file_get_integer(keyfile, "List", "margin_bottom", NULL);
-  }
+  g_clear_handle_id(&save_source_id, g_source_remove);
   
-  // AppEntry options
-  if (g_key_file_has_group(keyfile, "AppEntry")) {
-    config->app_icon_size = g_key_file_get_integer(keyfile, "AppEntry", "icon_size", NULL);
-    config->app_icon_corner_radius = g_key_file_get_integer(keyfile, "AppEntry", "icon_corner_radius", NULL);
-    g_free(config->app_icon_background_color);
-    config->app_icon_background_color = g_key_file_get_string(keyfile, "AppEntry", "icon_background_color", NULL);
-    config->app_name_font_size = g_key_file_get_integer(keyfile, "AppEntry", "name_font_size", NULL);
-    g_free(config->app_name_color);
-    config->app_name_color = g_key_file_get_string(keyfile, "AppEntry", "name_color", NULL);
-    config->app_desc_font_size = g_key_file_get_integer(keyfile, "AppEntry", "desc_font_size", NULL);
-    g_free(config->app_desc_color);
-    config->app_desc_color = g_key_file_get_string(keyfile, "AppEntry", "desc_color", NULL);
-    config->app_entry_padding = g_key_file_get_integer(keyfile, "AppEntry", "padding", NULL);
-    g_free(config->app_entry_hover_color);
-    config->app_entry_hover_color = g_key_file_get_string(keyfile, "AppEntry", "hover_color", NULL);
-    g_free(config->app_entry_active_color);
-    config->app_entry_active_color = g_key_file_get_string(keyfile, "AppEntry", "active_color", NULL);
+  g_print("Writing config to: %s\n", config->config_file);
+  g_autofree char *data = config_to_data(&local_error);
+  if (!data) {
+    g_warning("Failed to convert config to data: %s",
+              local_error ? local_error->message : "unknown error");
+    if (local_error) {
+      g_propagate_error(error, local_error);
+    }
+    return FALSE;
   }
   
-  // Category options
-  if (g_key_file_has_group(keyfile, "Category")) {
-    g_free(config->category_background_color);
-    config->category_background_color = g_key_file_get_string(keyfile, "Category", "background_color", NULL);
-    config->category_background_opacity = g_key_file_get_double(keyfile, "Category", "background_opacity", NULL);
-    config->category_corner_radius = g_key_file_get_integer(keyfile, "Category", "corner_radius", NULL);
-    g_free(config->category_text_color);
-    config->category_text_color = g_key_file_get_string(keyfile, "Category", "text_color", NULL);
-    config->category_font_size = g_key_file_get_integer(keyfile, "Category", "font_size", NULL);
-    g_free(config->category_font_family);
-    config->category_font_family = g_key_file_get_string(keyfile, "Category", "font_family", NULL);
-    config->category_padding = g_key_file_get_integer(keyfile, "Category", "padding", NULL);
-    config->category_show_separators = g_key_file_get_boolean(keyfile, "Category", "show_separators", NULL);
-    g_free(config->category_separator_color);
-    config->category_separator_color = g_key_file_get_string(keyfile, "Category", "separator_color", NULL);
+  config_dirty = FALSE;
+  if (!write_config(config->config_file, data, ++save_generation, &local_error)) {
+    g_warning("Failed to save config file: %s", local_error->message);
+    g_propagate_error(error, local_error);
+    config_dirty = TRUE;
+    return FALSE;
   }
+  set_synced(values_copy());
   
-  // Search options
-  if (g_key_file_has_group(keyfile, "Search")) {
-    config->search_background_color = g_key_file_get_string(keyfile, "Search", "background_color", NULL);
-    config->search_background_opacity = g_key_file_get_double(keyfile, "Search", "background_opacity", NULL);
-    config->search_corner_radius = g_key_file_get_integer(keyfile, "Search", "corner_radius", NULL);
-    g_free(config->search_text_color);
-    config->search_text_color = g_key_file_get_string(keyfile, "Search", "text_color", NULL);
-    g_free(config->search_font_family);
-    config->search_font_family = g_key_file_get_string(keyfile, "Search", "font_family", NULL);
-    config->search_padding = g_key_file_get_integer(keyfile, "Search", "padding", NULL);
-    config->search_min_height = g_key_file_get_integer(keyfile, "Search", "min_height", NULL);
-    config->search_left_padding = g_key_file_get_integer(keyfile, "Search", "left_padding", NULL);
-    config->search_length = g_key_file_get_integer(keyfile, "Search", "length", NULL);
-    g_free(config->search_placeholder_text);
-    config->search_placeholder_text = g_key_file_get_string(keyfile, "Search", "placeholder_text", NULL);
-    config->search_icon_size = g_key_file_get_integer(keyfile, "Search", "icon_size", NULL);
-    g_free(config->search_icon_color);
-    config->search_icon_color = g_key_file_get_string(keyfile, "Search", "icon_color", NULL);
-    g_free(config->search_focus_border_color);
-    config->search_focus_border_color = g_key_file_get_string(keyfile, "Search", "focus_border_color", NULL);
-    g_free(config->search_focus_shadow_color);
-    config->search_focus_shadow_color = g_key_file_get_string(keyfile, "Search", "focus_shadow_color", NULL);
+  g_print("Configuration saved successfully\n");
+  return TRUE;
+}
+
+gboolean
+hyprmenu_config_save()
+{
+  // Nothing changed since the config was loaded or last written
+  if (!config_dirty) {
+    g_clear_handle_id(&save_source_id, g_source_remove);
+    return TRUE;
   }
   
-  // SystemButton options
-  if (g_key_file_has_group(keyfile, "SystemButton")) {
-    g_free(config->system_button_background_color);
-    config->system_button_background_color = g_key_file_get_string(keyfile, "SystemButton", "background_color", NULL);
-    g_free(config->system_button_icon_color);
-    config->system_button_icon_color = g_key_file_get_string(keyfile, "SystemButton", "icon_color", NULL);
-    g_free(config->system_button_hover_color);
-    config->system_button_hover_color = g_key_file_get_string(keyfile, "SystemButton", "hover_color", NULL);
-    g_free(config->system_button_active_color);
-    config->system_button_active_color = g_key_file_get_string(keyfile, "SystemButton", "active_color", NULL);
-    config->system_button_corner_radius = g_key_file_get_integer(keyfile, "SystemButton", "corner_radius", NULL);
-    config->system_button_size = g_key_file_get_integer(keyfile, "SystemButton", "size", NULL);
-    config->system_button_spacing = g_key_file_get_integer(keyfile, "SystemButton", "spacing", NULL);
-  }
+  // Failures are logged there
+  return hyprmenu_config_save_with_error(NULL);
+}
+
+typedef struct {
+  char *path;
+  char *data;
+  guint64 generation;
+  HyprMenuConfig *values;  // What data holds; synced once written
+} ConfigWrite;
+
+static void
+config_write_free(gpointer data)
+{
+  ConfigWrite *write = data;
   
-  // Behavior options
-  if (g_key_file_has_group(keyfile, "Behavior")) {
-    if (g_key_file_has_key(keyfile, "Behavior", "close_on_click_outside", NULL)) {
-    config->close_on_click_outside = g_key_file_get_boolean(keyfile, "Behavior", "close_on_click_outside", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "close_on_super_key", NULL)) {
-    config->close_on_super_key = g_key_file_get_boolean(keyfile, "Behavior", "close_on_super_key", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "close_on_app_launch", NULL)) {
-    config->close_on_app_launch = g_key_file_get_boolean(keyfile, "Behavior", "close_on_app_launch", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "focus_search_on_open", NULL)) {
-    config->focus_search_on_open = g_key_file_get_boolean(keyfile, "Behavior", "focus_search_on_open", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "close_on_escape", NULL)) {
-    config->close_on_escape = g_key_file_get_boolean(keyfile, "Behavior", "close_on_escape", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "close_on_focus_out", NULL)) {
-    config->close_on_focus_out = g_key_file_get_boolean(keyfile, "Behavior", "close_on_focus_out", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_categories", NULL)) {
-    config->show_categories = g_key_file_get_boolean(keyfile, "Behavior", "show_categories", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_descriptions", NULL)) {
-    config->show_descriptions = g_key_file_get_boolean(keyfile, "Behavior", "show_descriptions", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_icons", NULL)) {
-    config->show_icons = g_key_file_get_boolean(keyfile, "Behavior", "show_icons", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_search", NULL)) {
-    config->show_search = g_key_file_get_boolean(keyfile, "Behavior", "show_search", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_scrollbar", NULL)) {
-    config->show_scrollbar = g_key_file_get_boolean(keyfile, "Behavior", "show_scrollbar", NULL);
-    }
-    
-    if (g_key_file_has_key(keyfile, "Behavior", "show_border", NULL)) {
-    config->show_border = g_key_file_get_boolean(keyfile, "Behavior", "show_border", NULL);
-  }
+  g_free(write->path);
+  g_free(write->data);
+  values_free(write->values);
+  g_free(write);
+}
+
+static void
+config_write_thread(GTask *task, gpointer source_object, gpointer task_data,
+                    GCancellable *cancellable)
+{
+  ConfigWrite *write = task_data;
+  GError *error = NULL;
   
-  if (g_key_file_has_key(keyfile, "Behavior", "show_shadow", NULL)) {
-    config->show_shadow = g_key_file_get_boolean(keyfile, "Behavior", "show_shadow", NULL);
-  }
+  (void)source_object;
+  (void)cancellable;
   
-    if (g_key_file_has_key(keyfile, "Behavior", "blur_background", NULL)) {
-      config->blur_background = g_key_file_get_boolean(keyfile, "Behavior", "blur_background", NULL);
+  if (!write_config(write->path, write->data, write->generation, &error)) {
+    g_task_return_error(task, error);
+    return;
   }
   
-    if (g_key_file_has_key(keyfile, "Behavior", "blur_strength", NULL)) {
-      config->blur_strength = g_key_file_get_integer(keyfile, "Behavior", "blur_strength", NULL);
+  g_task_return_boolean(task, TRUE);
+}
+
+static void
+on_config_written(GObject *source_object, GAsyncResult *result, gpointer user_data)
+{
+  GError *error = NULL;
+  
+  (void)source_object;
+  (void)user_data;
+  
+  if (!g_task_propagate_boolean(G_TASK(result), &error)) {
+    g_warning("Failed to save config file: %s", error->message);
+    g_error_free(error);
+    // Keep the changes so the next save, at the latest on exit, retries
+    config_dirty = TRUE;
+  } else {
+    ConfigWrite *write = g_task_get_task_data(G_TASK(result));
+    set_synced(g_steal_pointer(&write->values));
   }
   
-    if (g_key_file_has_key(keyfile, "Behavior", "opacity", NULL)) {
-      config->opacity = g_key_file_get_double(keyfile, "Behavior", "opacity", NULL);
+  save_in_flight = FALSE;
+  
+  // The file was edited during the write; read it now that ours is done
+  if (reload_pending) {
+    reload_pending = FALSE;
+    HyprMenuConfigSection changed = hyprmenu_config_reload();
+    if (changed && reload_func) {
+      reload_func(changed, reload_data);
     }
   }
   
-  // Hyprland-specific settings
-  if (g_key_file_has_group(keyfile, "Hyprland")) {
-    if (g_key_file_has_key(keyfile, "Hyprland", "use_hyprland_corner_fix", NULL)) {
-      config->use_hyprland_corner_fix = g_key_file_get_boolean(keyfile, "Hyprland", "use_hyprland_corner_fix", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Hyprland", "hyprland_corner_radius", NULL)) {
-      config->hyprland_corner_radius = g_key_file_get_integer(keyfile, "Hyprland", "hyprland_corner_radius", NULL);
-    }
+  if (save_pending) {
+    save_pending = FALSE;
+    hyprmenu_config_save_async();
   }
+}
+
+void
+hyprmenu_config_save_async()
+{
+  GError *error = NULL;
   
-  // Transparency section
-  if (g_key_file_has_group(keyfile, "Transparency")) {
-    if (g_key_file_has_key(keyfile, "Transparency", "enabled", NULL)) {
-      config->blur_background = g_key_file_get_boolean(keyfile, "Transparency", "enabled", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Transparency", "alpha", NULL)) {
-      config->opacity = g_key_file_get_double(keyfile, "Transparency", "alpha", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Transparency", "blur", NULL)) {
-      config->blur_background = g_key_file_get_boolean(keyfile, "Transparency", "blur", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Transparency", "shadow", NULL)) {
-      config->show_shadow = g_key_file_get_boolean(keyfile, "Transparency", "shadow", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Transparency", "shadow_color", NULL)) {
-      g_free(config->window_shadow_color);
-      config->window_shadow_color = g_key_file_get_string(keyfile, "Transparency", "shadow_color", NULL);
-    }
-    if (g_key_file_has_key(keyfile, "Transparency", "shadow_radius", NULL)) {
-      config->window_shadow_radius = g_key_file_get_integer(keyfile, "Transparency", "shadow_radius", NULL);
-    }
+  g_clear_handle_id(&save_source_id, g_source_remove);
+  
+  if (save_in_flight) {
+    save_pending = TRUE;
+    return;
   }
   
-  // Behavior options
-  config->max_recent_apps = g_key_file_get_integer(keyfile, "Behavior", "max_recent_apps", NULL);
-  if (config->max_recent_apps <= 0) {
-    config->max_recent_apps = 10;  // Default if not set or invalid
+  if (!config_dirty) {
+    return;
   }
-  // Save config back if any missing options
-  if (missing_option) {
-    hyprmenu_config_save();
+  
+  char *data = config_to_data(&error);
+  if (!data) {
+    g_warning("Failed to convert config to data: %s", error->message);
+    g_error_free(error);
+    return;
   }
   
-  return TRUE;
+  ConfigWrite *write = g_new0(ConfigWrite, 1);
+  write->path = g_strdup(config->config_file);
+  write->data = data;
+  write->generation = ++save_generation;
+  write->values = values_copy();
+  
+  config_dirty = FALSE;
+  save_in_flight = TRUE;
+  GTask *task = g_task_new(NULL, NULL, on_config_written, NULL);
+  g_task_set_task_data(task, write, config_write_free);
+  g_task_run_in_thread(task, config_write_thread);
+  g_object_unref(task);
 }
 
-gboolean
-hyprmenu_config_save_with_error(GError **error)
+static gboolean
+on_save_timeout(gpointer user_data)
 {
-  g_autoptr(GKeyFile) keyfile = g_key_file_new();
-  static gboolean is_saving = FALSE;
+  (void)user_data;
   
-  if (is_saving) {
-    return TRUE;
+  save_source_id = 0;
+  hyprmenu_config_save_async();
+  return G_SOURCE_REMOVE;
+}
+
+void
+hyprmenu_config_mark_dirty()
+{
+  config_dirty = TRUE;
+  
+  // Restart the delay so a burst of changes is written once
+  g_clear_handle_id(&save_source_id, g_source_remove);
+  save_source_id = g_timeout_add(CONFIG_SAVE_DELAY_MS, on_save_timeout, NULL);
+}
+
+void
+hyprmenu_config_set_reload_func(HyprMenuConfigReloadFunc func, gpointer user_data)
+{
+  reload_func = func;
+  reload_data = user_data;
+}
+
+HyprMenuConfigSection
+hyprmenu_config_reload()
+{
+  g_autofree char *contents = NULL;
+  gboolean ours;
+  
+  if (!g_file_get_contents(config->config_file, &contents, NULL, NULL)) {
+    return 0;
   }
   
-  is_saving = TRUE;
+  // Our own saves come back as change notifications too
+  g_mutex_lock(&write_mutex);
+  ours = g_strcmp0(contents, written_data) == 0;
+  g_mutex_unlock(&write_mutex);
+  if (ours) {
+    return 0;
+  }
   
-  // Add header comments
-  g_key_file_set_comment(keyfile, NULL, NULL, 
-    "# HyprMenu Configuration File\n"
-    "# This file controls the appearance and behavior of HyprMenu\n"
-    "# All color values support #RRGGBB, #RRGGBBAA, rgb(), or rgba() formats", NULL);
-
-  // Layout section
-  g_key_file_set_comment(keyfile, "Layout", NULL,
-    "# Main window dimensions and positioning", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "window_width", config->window_width);
-  g_key_file_set_comment(keyfile, "Layout", "window_width", "Width of the menu window in pixels", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "window_height", config->window_height);
-  g_key_file_set_comment(keyfile, "Layout", "window_height", "Height of the menu window in pixels", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "top_margin", config->top_margin);
-  g_key_file_set_comment(keyfile, "Layout", "top_margin", "Margin from the top of the screen", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "left_margin", config->left_margin);
-  g_key_file_set_comment(keyfile, "Layout", "left_margin", "Margin from the left of the screen", NULL);
-  g_key_file_set_boolean(keyfile, "Layout", "center_window", config->center_window);
-  g_key_file_set_comment(keyfile, "Layout", "center_window", "Whether to center the window on screen", NULL);
-  g_key_file_set_string(keyfile, "Layout", "menu_position", hyprmenu_position_to_string(config->menu_position));
-  g_key_file_set_comment(keyfile, "Layout", "menu_position", "Position of the menu (top-left, top-center, top-right, bottom-left, bottom-center, bottom-right, center)", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "bottom_offset", config->bottom_offset);
-  g_key_file_set_comment(keyfile, "Layout", "bottom_offset", "Offset from bottom for dock/panel (0 to respect reserved space)", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "top_offset", config->top_offset);
-  g_key_file_set_comment(keyfile, "Layout", "top_offset", "Offset from top for panel", NULL);
-  g_key_file_set_integer(keyfile, "Layout", "window_padding", config->window_padding);
-  g_key_file_set_comment(keyfile, "Layout", "window_padding", "Internal padding of the main window", NULL);
-
-  // Window section
-  g_key_file_set_comment(keyfile, "Window", NULL,
-    "# Main window appearance", NULL);
-  g_key_file_set_string(keyfile, "Window", "background_color", config->window_background_color);
-  g_key_file_set_comment(keyfile, "Window", "background_color", "Window background color (empty for transparent)", NULL);
-  g_key_file_set_double(keyfile, "Window", "background_opacity", config->window_background_opacity);
-  g_key_file_set_comment(keyfile, "Window", "background_opacity", "Overall window opacity (0.0 to 1.0)", NULL);
-  g_key_file_set_double(keyfile, "Window", "background_blur", config->window_background_blur);
-  g_key_file_set_comment(keyfile, "Window", "background_blur", "Background blur strength", NULL);
-  g_key_file_set_integer(keyfile, "Window", "corner_radius", config->window_corner_radius);
-  g_key_file_set_comment(keyfile, "Window", "corner_radius", "Window corner radius", NULL);
-  g_key_file_set_string(keyfile, "Window", "halign", config->window_halign);
-  g_key_file_set_comment(keyfile, "Window", "halign", "Horizontal alignment (start, center, end)", NULL);
-  g_key_file_set_string(keyfile, "Window", "valign", config->window_valign);
-  g_key_file_set_comment(keyfile, "Window", "valign", "Vertical alignment (start, center, end)", NULL);
-  g_key_file_set_string(keyfile, "Window", "shadow_color", config->window_shadow_color);
-  g_key_file_set_comment(keyfile, "Window", "shadow_color", "Window shadow color", NULL);
-  g_key_file_set_integer(keyfile, "Window", "shadow_radius", config->window_shadow_radius);
-  g_key_file_set_comment(keyfile, "Window", "shadow_radius", "Window shadow radius", NULL);
-  g_key_file_set_double(keyfile, "Window", "opacity", config->opacity);
-  g_key_file_set_comment(keyfile, "Window", "opacity", "Overall window opacity", NULL);
-
-  // Border section
-  g_key_file_set_comment(keyfile, "Border", NULL,
-    "# Border appearance settings", NULL);
-  g_key_file_set_string(keyfile, "Border", "inner_border_color", config->inner_border_color);
-  g_key_file_set_comment(keyfile, "Border", "inner_border_color", "Color of the inner border", NULL);
-  g_key_file_set_integer(keyfile, "Border", "inner_border_radius", config->inner_border_radius);
-  g_key_file_set_comment(keyfile, "Border", "inner_border_radius", "Radius of inner border corners", NULL);
-  g_key_file_set_integer(keyfile, "Border", "inner_border_width", config->inner_border_width);
-  g_key_file_set_comment(keyfile, "Border", "inner_border_width", "Width of inner border", NULL);
-  g_key_file_set_string(keyfile, "Border", "outer_border_color", config->outer_border_color);
-  g_key_file_set_comment(keyfile, "Border", "outer_border_color", "Color of the outer border", NULL);
-  g_key_file_set_integer(keyfile, "Border", "outer_border_radius", config->outer_border_radius);
-  g_key_file_set_comment(keyfile, "Border", "outer_border_radius", "Radius of outer border corners", NULL);
-  g_key_file_set_integer(keyfile, "Border", "outer_border_width", config->outer_border_width);
-  g_key_file_set_comment(keyfile, "Border", "outer_border_width", "Width of outer border", NULL);
-
-  // Grid section
-  g_key_file_set_comment(keyfile, "Grid", NULL,
-    "# Grid view settings (when showing apps in grid mode)", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "columns", config->grid_columns);
-  g_key_file_set_comment(keyfile, "Grid", "columns", "Number of columns in grid", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "item_size", config->grid_item_size);
-  g_key_file_set_comment(keyfile, "Grid", "item_size", "Size of each grid item", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "item_corner_radius", config->grid_item_corner_radius);
-  g_key_file_set_comment(keyfile, "Grid", "item_corner_radius", "Corner radius of grid items", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "item_border_width", config->grid_item_border_width);
-  g_key_file_set_comment(keyfile, "Grid", "item_border_width", "Border width of grid items", NULL);
-  g_key_file_set_string(keyfile, "Grid", "item_border_color", config->grid_item_border_color);
-  g_key_file_set_comment(keyfile, "Grid", "item_border_color", "Border color of grid items", NULL);
-  g_key_file_set_string(keyfile, "Grid", "item_background_color", config->grid_item_background_color);
-  g_key_file_set_comment(keyfile, "Grid", "item_background_color", "Background color of grid items", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "row_spacing", config->grid_row_spacing);
-  g_key_file_set_comment(keyfile, "Grid", "row_spacing", "Vertical spacing between rows", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "column_spacing", config->grid_column_spacing);
-  g_key_file_set_comment(keyfile, "Grid", "column_spacing", "Horizontal spacing between columns", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "margin_start", config->grid_margin_start);
-  g_key_file_set_comment(keyfile, "Grid", "margin_start", "Left margin", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "margin_end", config->grid_margin_end);
-  g_key_file_set_comment(keyfile, "Grid", "margin_end", "Right margin", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "margin_top", config->grid_margin_top);
-  g_key_file_set_comment(keyfile, "Grid", "margin_top", "Top margin", NULL);
-  g_key_file_set_integer(keyfile, "Grid", "margin_bottom", config->grid_margin_bottom);
-  g_key_file_set_comment(keyfile, "Grid", "margin_bottom", "Bottom margin", NULL);
-  g_key_file_set_string(keyfile, "Grid", "halign", config->grid_halign);
-  g_key_file_set_comment(keyfile, "Grid", "halign", "Horizontal alignment of grid", NULL);
-  g_key_file_set_string(keyfile, "Grid", "valign", config->grid_valign);
-  g_key_file_set_comment(keyfile, "Grid", "valign", "Vertical alignment of grid", NULL);
-  g_key_file_set_boolean(keyfile, "Grid", "hexpand", config->grid_hexpand);
-  g_key_file_set_comment(keyfile, "Grid", "hexpand", "Whether grid expands horizontally", NULL);
-  g_key_file_set_boolean(keyfile, "Grid", "vexpand", config->grid_vexpand);
-  g_key_file_set_comment(keyfile, "Grid", "vexpand", "Whether grid expands vertically", NULL);
-  g_key_file_set_double(keyfile, "Grid", "opacity", config->grid_opacity);
-  g_key_file_set_comment(keyfile, "Grid", "opacity", "Overall grid opacity", NULL);
-  g_key_file_set_double(keyfile, "Grid", "item_opacity", config->grid_item_opacity);
-  g_key_file_set_comment(keyfile, "Grid", "item_opacity", "Individual item opacity", NULL);
-
-  // List section
-  g_key_file_set_comment(keyfile, "List", NULL,
-    "# List view settings (when showing apps in list mode)", NULL);
-  g_key_file_set_integer(keyfile, "List", "item_size", config->list_item_size);
-  g_key_file_set_comment(keyfile, "List", "item_size", "Height of each list item", NULL);
-  g_key_file_set_integer(keyfile, "List", "item_corner_radius", config->list_item_corner_radius);
-  g_key_file_set_comment(keyfile, "List", "item_corner_radius", "Corner radius of list items", NULL);
-  g_key_file_set_integer(keyfile, "List", "item_border_width", config->list_item_border_width);
-  g_key_file_set_comment(keyfile, "List", "item_border_width", "Border width of list items", NULL);
-  g_key_file_set_string(keyfile, "List", "item_border_color", config->list_item_border_color);
-  g_key_file_set_comment(keyfile, "List", "item_border_color", "Border color of list items", NULL);
-  g_key_file_set_string(keyfile, "List", "item_background_color", config->list_item_background_color);
-  g_key_file_set_comment(keyfile, "List", "item_background_color", "Background color of list items", NULL);
-  g_key_file_set_integer(keyfile, "List", "row_spacing", config->list_row_spacing);
-  g_key_file_set_comment(keyfile, "List", "row_spacing", "Vertical spacing between items", NULL);
-  g_key_file_set_integer(keyfile, "List", "margin_start", config->grid_margin_start);
-  g_key_file_set_comment(keyfile, "List", "margin_start", "Left margin", NULL);
-  g_key_file_set_integer(keyfile, "List", "margin_end", config->grid_margin_end);
-  g_key_file_set_comment(keyfile, "List", "margin_end", "Right margin", NULL);
-  g_key_file_set_integer(keyfile, "List", "margin_top", config->grid_margin_top);
-  g_key_file_set_comment(keyfile, "List", "margin_top", "Top margin", NULL);
-  g_key_file_set_integer(keyfile, "List", "margin_bottom", config->grid_margin_bottom);
-  g_key_file_set_comment(keyfile, "List", "margin_bottom", "Bottom margin", NULL);
-  g_key_file_set_string(keyfile, "List", "halign", config->list_halign);
-  g_key_file_set_comment(keyfile, "List", "halign", "Horizontal alignment of list", NULL);
-  g_key_file_set_string(keyfile, "List", "valign", config->list_valign);
-  g_key_file_set_comment(keyfile, "List", "valign", "Vertical alignment of list", NULL);
-  g_key_file_set_boolean(keyfile, "List", "hexpand", config->list_hexpand);
-  g_key_file_set_comment(keyfile, "List", "hexpand", "Whether list expands horizontally", NULL);
-  g_key_file_set_boolean(keyfile, "List", "vexpand", config->list_vexpand);
-  g_key_file_set_comment(keyfile, "List", "vexpand", "Whether list expands vertically", NULL);
-  g_key_file_set_double(keyfile, "List", "opacity", config->grid_opacity);
-  g_key_file_set_comment(keyfile, "List", "opacity", "Overall list opacity", NULL);
-  g_key_file_set_double(keyfile, "List", "item_opacity", config->grid_item_opacity);
-  g_key_file_set_comment(keyfile, "List", "item_opacity", "Individual item opacity", NULL);
-
-  // AppEntry section
-  g_key_file_set_comment(keyfile, "AppEntry", NULL,
-    "# Individual application entry appearance", NULL);
-  g_key_file_set_integer(keyfile, "AppEntry", "icon_size", config->app_icon_size);
-  g_key_file_set_comment(keyfile, "AppEntry", "icon_size", "Size of application icons", NULL);
-  g_key_file_set_integer(keyfile, "AppEntry", "icon_corner_radius", config->app_icon_corner_radius);
-  g_key_file_set_comment(keyfile, "AppEntry", "icon_corner_radius", "Corner radius of icons", NULL);
-  g_key_file_set_string(keyfile, "AppEntry", "icon_background_color", config->app_icon_background_color);
-  g_key_file_set_comment(keyfile, "AppEntry", "icon_background_color", "Background color behind icons", NULL);
-  g_key_file_set_integer(keyfile, "AppEntry", "name_font_size", config->app_name_font_size);
-  g_key_file_set_comment(keyfile, "AppEntry", "name_font_size", "Font size of application names", NULL);
-  g_key_file_set_string(keyfile, "AppEntry", "name_color", config->app_name_color);
-  g_key_file_set_comment(keyfile, "AppEntry", "name_color", "Color of application names", NULL);
-  g_key_file_set_integer(keyfile, "AppEntry", "desc_font_size", config->app_desc_font_size);
-  g_key_file_set_comment(keyfile, "AppEntry", "desc_font_size", "Font size of application descriptions", NULL);
-  g_key_file_set_string(keyfile, "AppEntry", "desc_color", config->app_desc_color);
-  g_key_file_set_comment(keyfile, "AppEntry", "desc_color", "Color of application descriptions", NULL);
-  g_key_file_set_integer(keyfile, "AppEntry", "padding", config->app_entry_padding);
-  g_key_file_set_comment(keyfile, "AppEntry", "padding", "Internal padding of entries", NULL);
-  g_key_file_set_string(keyfile, "AppEntry", "hover_color", config->app_entry_hover_color);
-  g_key_file_set_comment(keyfile, "AppEntry", "hover_color", "Background color on hover", NULL);
-  g_key_file_set_string(keyfile, "AppEntry", "active_color", config->app_entry_active_color);
-  g_key_file_set_comment(keyfile, "AppEntry", "active_color", "Background color when clicked", NULL);
-  g_key_file_set_double(keyfile, "AppEntry", "opacity", config->app_entry_opacity);
-  g_key_file_set_comment(keyfile, "AppEntry", "opacity", "Overall entry opacity", NULL);
-  g_key_file_set_double(keyfile, "AppEntry", "icon_opacity", config->app_icon_opacity);
-  g_key_file_set_comment(keyfile, "AppEntry", "icon_opacity", "Icon opacity", NULL);
-  g_key_file_set_double(keyfile, "AppEntry", "name_opacity", config->app_name_opacity);
-  g_key_file_set_comment(keyfile, "AppEntry", "name_opacity", "Name text opacity", NULL);
-  g_key_file_set_double(keyfile, "AppEntry", "desc_opacity", config->app_desc_opacity);
-  g_key_file_set_comment(keyfile, "AppEntry", "desc_opacity", "Description text opacity", NULL);
-
-  // Category section
-  g_key_file_set_comment(keyfile, "Category", NULL,
-    "# Category header appearance", NULL);
-  g_key_file_set_string(keyfile, "Category", "background_color", config->category_background_color);
-  g_key_file_set_comment(keyfile, "Category", "background_color", "Category background color", NULL);
-  g_key_file_set_double(keyfile, "Category", "background_opacity", config->category_background_opacity);
-  g_key_file_set_comment(keyfile, "Category", "background_opacity", "Category background opacity", NULL);
-  g_key_file_set_integer(keyfile, "Category", "corner_radius", config->category_corner_radius);
-  g_key_file_set_comment(keyfile, "Category", "corner_radius", "Corner radius of category headers", NULL);
-  g_key_file_set_string(keyfile, "Category", "text_color", config->category_text_color);
-  g_key_file_set_comment(keyfile, "Category", "text_color", "Category text color", NULL);
-  g_key_file_set_integer(keyfile, "Category", "font_size", config->category_font_size);
-  g_key_file_set_comment(keyfile, "Category", "font_size", "Category text size", NULL);
-  g_key_file_set_string(keyfile, "Category", "font_family", config->category_font_family);
-  g_key_file_set_comment(keyfile, "Category", "font_family", "Category font family", NULL);
-  g_key_file_set_integer(keyfile, "Category", "padding", config->category_padding);
-  g_key_file_set_comment(keyfile, "Category", "padding", "Internal padding of categories", NULL);
-  g_key_file_set_boolean(keyfile, "Category", "show_separators", config->show_categories);
-  g_key_file_set_comment(keyfile, "Category", "show_separators", "Whether to show separators between categories", NULL);
-  g_key_file_set_string(keyfile, "Category", "separator_color", config->category_separator_color);
-  g_key_file_set_comment(keyfile, "Category", "separator_color", "Color of category separators", NULL);
-  g_key_file_set_double(keyfile, "Category", "opacity", config->category_opacity);
-  g_key_file_set_comment(keyfile, "Category", "opacity", "Overall category opacity", NULL);
-  g_key_file_set_double(keyfile, "Category", "title_opacity", config->category_title_opacity);
-  g_key_file_set_comment(keyfile, "Category", "title_opacity", "Category title opacity", NULL);
-
-  // Search section
-  g_key_file_set_comment(keyfile, "Search", NULL,
-    "# Search bar appearance and behavior", NULL);
-  g_key_file_set_string(keyfile, "Search", "background_color", config->search_background_color);
-  g_key_file_set_comment(keyfile, "Search", "background_color", "Search bar background color", NULL);
-  g_key_file_set_double(keyfile, "Search", "background_opacity", config->search_background_opacity);
-  g_key_file_set_comment(keyfile, "Search", "background_opacity", "Search bar background opacity", NULL);
-  g_key_file_set_integer(keyfile, "Search", "corner_radius", config->search_corner_radius);
-  g_key_file_set_comment(keyfile, "Search", "corner_radius", "Corner radius of search bar", NULL);
-  g_key_file_set_string(keyfile, "Search", "text_color", config->search_text_color);
-  g_key_file_set_comment(keyfile, "Search", "text_color", "Search text color", NULL);
-  g_key_file_set_integer(keyfile, "Search", "font_size", config->search_font_size);
-  g_key_file_set_comment(keyfile, "Search", "font_size", "Search text size", NULL);
-  g_key_file_set_string(keyfile, "Search", "font_family", config->search_font_family);
-  g_key_file_set_comment(keyfile, "Search", "font_family", "Search text font", NULL);
-  g_key_file_set_integer(keyfile, "Search", "padding", config->search_padding);
-  g_key_file_set_comment(keyfile, "Search", "padding", "Internal padding of search bar", NULL);
-  g_key_file_set_integer(keyfile, "Search", "min_height", config->search_min_height);
-  g_key_file_set_comment(keyfile, "Search", "min_height", "Minimum height of search bar", NULL);
-  g_key_file_set_integer(keyfile, "Search", "left_padding", config->search_left_padding);
-  g_key_file_set_comment(keyfile, "Search", "left_padding", "Left padding of search text", NULL);
-  g_key_file_set_integer(keyfile, "Search", "length", config->search_length);
-  g_key_file_set_comment(keyfile, "Search", "length", "Maximum search text length (0 for unlimited)", NULL);
-  g_key_file_set_string(keyfile, "Search", "placeholder_text", config->search_placeholder_text);
-  g_key_file_set_comment(keyfile, "Search", "placeholder_text", "Placeholder text when empty", NULL);
-  g_key_file_set_integer(keyfile, "Search", "icon_size", config->search_icon_size);
-  g_key_file_set_comment(keyfile, "Search", "icon_size", "Size of search icon", NULL);
-  g_key_file_set_string(keyfile, "Search", "icon_color", config->search_icon_color);
-  g_key_file_set_comment(keyfile, "Search", "icon_color", "Color of search icon", NULL);
-  g_key_file_set_string(keyfile, "Search", "focus_border_color", config->search_focus_border_color);
-  g_key_file_set_comment(keyfile, "Search", "focus_border_color", "Border color when focused", NULL);
-  g_key_file_set_string(keyfile, "Search", "focus_shadow_color", config->search_focus_shadow_color);
-  g_key_file_set_comment(keyfile, "Search", "focus_shadow_color", "Shadow color when focused", NULL);
-  g_key_file_set_double(keyfile, "Search", "opacity", config->search_opacity);
-  g_key_file_set_comment(keyfile, "Search", "opacity", "Overall search bar opacity", NULL);
-  g_key_file_set_double(keyfile, "Search", "text_opacity", config->search_text_opacity);
-  g_key_file_set_comment(keyfile, "Search", "text_opacity", "Search text opacity", NULL);
-  g_key_file_set_double(keyfile, "Search", "icon_opacity", config->search_icon_opacity);
-  g_key_file_set_comment(keyfile, "Search", "icon_opacity", "Search icon opacity", NULL);
-
-  // SystemButton section
-  g_key_file_set_comment(keyfile, "SystemButton", NULL,
-    "# System button appearance (power, settings, etc.)", NULL);
-  g_key_file_set_string(keyfile, "SystemButton", "background_color", config->system_button_background_color);
-  g_key_file_set_comment(keyfile, "SystemButton", "background_color", "Button background color", NULL);
-  g_key_file_set_string(keyfile, "SystemButton", "icon_color", config->system_button_icon_color);
-  g_key_file_set_comment(keyfile, "SystemButton", "icon_color", "Button icon color", NULL);
-  g_key_file_set_string(keyfile, "SystemButton", "hover_color", config->system_button_hover_color);
-  g_key_file_set_comment(keyfile, "SystemButton", "hover_color", "Background color on hover", NULL);
-  g_key_file_set_string(keyfile, "SystemButton", "active_color", config->system_button_active_color);
-  g_key_file_set_comment(keyfile, "SystemButton", "active_color", "Background color when clicked", NULL);
-  g_key_file_set_integer(keyfile, "SystemButton", "corner_radius", config->system_button_corner_radius);
-  g_key_file_set_comment(keyfile, "SystemButton", "corner_radius", "Corner radius of buttons", NULL);
-  g_key_file_set_integer(keyfile, "SystemButton", "size", config->system_button_size);
-  g_key_file_set_comment(keyfile, "SystemButton", "size", "Size of buttons", NULL);
-  g_key_file_set_integer(keyfile, "SystemButton", "spacing", config->system_button_spacing);
-  g_key_file_set_comment(keyfile, "SystemButton", "spacing", "Space between buttons", NULL);
-  g_key_file_set_double(keyfile, "SystemButton", "opacity", config->system_button_opacity);
-  g_key_file_set_comment(keyfile, "SystemButton", "opacity", "Overall button opacity", NULL);
-  g_key_file_set_double(keyfile, "SystemButton", "icon_opacity", config->system_button_icon_opacity);
-  g_key_file_set_comment(keyfile, "SystemButton", "icon_opacity", "Button icon opacity", NULL);
-
-  // Behavior section
-  g_key_file_set_comment(keyfile, "Behavior", NULL,
-    "# Program behavior settings", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "close_on_click_outside", config->close_on_click_outside);
-  g_key_file_set_comment(keyfile, "Behavior", "close_on_click_outside", "Close when clicking outside the menu", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "close_on_super_key", config->close_on_super_key);
-  g_key_file_set_comment(keyfile, "Behavior", "close_on_super_key", "Close when pressing Super key", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "close_on_app_launch", config->close_on_app_launch);
-  g_key_file_set_comment(keyfile, "Behavior", "close_on_app_launch", "Close when launching an application", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "focus_search_on_open", config->focus_search_on_open);
-  g_key_file_set_comment(keyfile, "Behavior", "focus_search_on_open", "Focus search bar when opening", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "close_on_escape", config->close_on_escape);
-  g_key_file_set_comment(keyfile, "Behavior", "close_on_escape", "Close when pressing Escape", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "close_on_focus_out", config->close_on_focus_out);
-  g_key_file_set_comment(keyfile, "Behavior", "close_on_focus_out", "Close when losing focus", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_categories", config->show_categories);
-  g_key_file_set_comment(keyfile, "Behavior", "show_categories", "Show application categories", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_descriptions", config->show_descriptions);
-  g_key_file_set_comment(keyfile, "Behavior", "show_descriptions", "Show application descriptions", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_icons", config->show_icons);
-  g_key_file_set_comment(keyfile, "Behavior", "show_icons", "Show application icons", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_search", config->show_search);
-  g_key_file_set_comment(keyfile, "Behavior", "show_search", "Show search bar", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_scrollbar", config->show_scrollbar);
-  g_key_file_set_comment(keyfile, "Behavior", "show_scrollbar", "Show scrollbar", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_border", config->show_border);
-  g_key_file_set_comment(keyfile, "Behavior", "show_border", "Show window border", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "show_shadow", config->show_shadow);
-  g_key_file_set_comment(keyfile, "Behavior", "show_shadow", "Show window shadow", NULL);
-  g_key_file_set_boolean(keyfile, "Behavior", "blur_background", config->blur_background);
-  g_key_file_set_comment(keyfile, "Behavior", "blur_background", "Enable background blur", NULL);
-  g_key_file_set_integer(keyfile, "Behavior", "blur_strength", config->blur_strength);
-  g_key_file_set_comment(keyfile, "Behavior", "blur_strength", "Background blur strength", NULL);
-  g_key_file_set_integer(keyfile, "Behavior", "max_recent_apps", config->max_recent_apps);
-  g_key_file_set_comment(keyfile, "Behavior", "max_recent_apps", "Maximum number of recent apps to show", NULL);
-
-  // Transparency section
-  g_key_file_set_comment(keyfile, "Transparency", NULL,
-    "# Global transparency settings", NULL);
-  g_key_file_set_boolean(keyfile, "Transparency", "enabled", config->blur_background);
-  g_key_file_set_comment(keyfile, "Transparency", "enabled", "Enable transparency effects", NULL);
-  g_key_file_set_double(keyfile, "Transparency", "alpha", config->opacity);
-  g_key_file_set_comment(keyfile, "Transparency", "alpha", "Global alpha value (0.0 to 1.0)", NULL);
-  g_key_file_set_boolean(keyfile, "Transparency", "blur", config->blur_background);
-  g_key_file_set_comment(keyfile, "Transparency", "blur", "Enable blur effects", NULL);
-  g_key_file_set_boolean(keyfile, "Transparency", "shadow", config->show_shadow);
-  g_key_file_set_comment(keyfile, "Transparency", "shadow", "Enable shadow effects", NULL);
-  g_key_file_set_string(keyfile, "Transparency", "shadow_color", config->window_shadow_color);
-  g_key_file_set_comment(keyfile, "Transparency", "shadow_color", "Shadow color", NULL);
-  g_key_file_set_integer(keyfile, "Transparency", "shadow_radius", config->window_shadow_radius);
-  g_key_file_set_comment(keyfile, "Transparency", "shadow_radius", "Shadow radius", NULL);
-
-  // Hyprland section
-  g_key_file_set_comment(keyfile, "Hyprland", NULL,
-    "# Hyprland-specific settings", NULL);
-  g_key_file_set_boolean(keyfile, "Hyprland", "use_hyprland_corner_fix", config->use_hyprland_corner_fix);
-  g_key_file_set_comment(keyfile, "Hyprland", "use_hyprland_corner_fix", "Enable corner artifact fix for Hyprland", NULL);
-  g_key_file_set_integer(keyfile, "Hyprland", "hyprland_corner_radius", config->hyprland_corner_radius);
-  g_key_file_set_comment(keyfile, "Hyprland", "hyprland_corner_radius", "Corner radius to use with Hyprland fix", NULL);
-
-  // Save to file
-  g_print("Writing config to: %s\n", config->config_file);
-  g_autofree char *data = g_key_file_to_data(keyfile, NULL, error);
-  if (!data) {
-    g_warning("Failed to convert config to data: %s", (*error)->message);
-    is_saving = FALSE;
-    return FALSE;
+  // Don't race the write; on_config_written() comes back here
+  if (save_in_flight) {
+    reload_pending = TRUE;
+    return 0;
   }
   
-  if (!g_file_set_contents(config->config_file, data, -1, error)) {
-    g_warning("Failed to save config file: %s", (*error)->message);
-    is_saving = FALSE;
-    return FALSE;
+  g_autoptr(GKeyFile) before = config_to_keyfile();
+  HyprMenuConfig *mine = config_dirty ? values_copy() : NULL;
+  HyprMenuConfig *base = mine ? g_steal_pointer(&synced) : NULL;
+  
+  if (!load_file()) {
+    // Nothing was replaced, so pending changes stay as they are
+    if (base) {
+      set_synced(base);
+    }
+    values_free(mine);
+    return 0;
+  }
+  
+  /* Changes of our own that were not written yet win over the file for
+   * the keys they touched; the rest comes from the edit. Without a base
+   * there is no telling what we changed, so the file wins. */
+  if (mine && base) {
+    gboolean kept = FALSE;
+    
+    for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+      const ConfigKey *key = &config_keys[i];
+      if (!value_equal(mine, base, key)) {
+        copy_value(config, mine, key);
+        kept = TRUE;
+      }
+    }
+    if (kept) {
+      hyprmenu_config_mark_dirty();
+    }
   }
+  values_free(base);
+  values_free(mine);
   
-  // Force sync to ensure the file is written to disk
-  fsync(0);  // Use fsync on stdout instead of sync()
+  g_autoptr(GKeyFile) after = config_to_keyfile();
   
-  g_print("Configuration saved successfully\n");
-  is_saving = FALSE;
-  return TRUE;
+  HyprMenuConfigSection changed = diff_sections(before, after);
+  g_print("Config reloaded, changed sections: 0x%x\n", changed);
+  return changed;
 }
 
-gboolean
-hyprmenu_config_save()
+/* Generated CSS. One provider stays on the display and is reloaded in
+ * place; the text is cached on disk under a hash of the config sections
+ * it is generated from, so an unchanged style is loaded as is. */
+#define CSS_CACHE_VERSION 1
+
+static GtkCssProvider *css_provider = NULL;
+static guint64 css_hash = 0;  // Style the provider holds, 0 for none
+
+/* Part of the menu a key configures, 0 for keys of legacy groups */
+static HyprMenuConfigSection
+key_section(const ConfigKey *key)
 {
-  GError *error = NULL;
-  gboolean result = hyprmenu_config_save_with_error(&error);
+  for (gsize i = 0; i < G_N_ELEMENTS(config_groups); i++) {
+    if (strcmp(config_groups[i].group, key->group) == 0) {
+      return config_groups[i].section;
+    }
+  }
+  return 0;
+}
+
+/* Hash of every key in the sections the stylesheet is generated from.
+ * That covers more than generate_css() reads, which only costs a
+ * regeneration now and then, but a field added to the stylesheet can
+ * never be left out. Legacy keys share their fields with current ones. */
+static guint64
+style_hash(void)
+{
+  guint64 hash = HASH_INIT;
   
-  if (!result && error) {
-    g_warning("Config save failed: %s", error->message);
-    g_error_free(error);
+  hash = hash_int(hash, CSS_CACHE_VERSION);
+  
+  for (gsize i = 0; i < G_N_ELEMENTS(config_keys); i++) {
+    const ConfigKey *key = &config_keys[i];
+    gpointer field = key_field(config, key);
+    
+    if (!(key_section(key) & HYPRMENU_CONFIG_STYLE_SECTIONS)) {
+      continue;
+    }
+    
+    switch (key->type) {
+      case CONFIG_INT:
+      case CONFIG_BOOL:
+        hash = hash_int(hash, *(int *)field);
+        break;
+      case CONFIG_DOUBLE:
+        hash = hash_double(hash, *(double *)field);
+        break;
+      case CONFIG_POSITION:
+        hash = hash_int(hash, *(HyprMenuPosition *)field);
+        break;
+      case CONFIG_STRING:
+        hash = hash_string(hash, *(char **)field);
+        break;
+    }
   }
   
-  return result;
+  // Never 0, which marks an empty provider
+  return hash ? hash : 1;
 }
 
-void
-hyprmenu_config_apply_css()
+static char *
+css_cache_path(void)
+{
+  return g_build_filename(g_get_user_cache_dir(), "hyprmenu", "style.css", NULL);
+}
+
+/* First line of a cached stylesheet, naming the style it was made for */
+static char *
+css_cache_header(guint64 hash)
+{
+  return g_strdup_printf("/* hyprmenu style %016" G_GINT64_MODIFIER "x */\n", hash);
+}
+
+static GString *
+generate_css(void)
 {
-  if (!config) return;
   GString *css = g_string_new("");
 
+  // Empty background color means the default color at the configured opacity
+  g_autofree char *window_background = NULL;
+  if (config->window_background_color && strlen(config->window_background_color) > 0) {
+    window_background = g_strdup(config->window_background_color);
+  } else {
+    window_background = g_strdup_printf("rgba(20, 20, 20, %.2f)", config->window_background_opacity);
+  }
+
   // Create CSS string
   g_string_append_printf(css,
     "window, .background {\n"
@@ -1042,21 +1506,14 @@ hyprmenu_config_apply_css()
     "  overflow: hidden;\n"
     "}\n\n"
     ".hyprmenu-window {\n"
-    "  background-color: %s%s;\n"
+    "  background-color: %s;\n"
     "  border-radius: %dpx;\n"
     "  border: %dpx solid %s;\n"
     "  padding: %dpx;\n"
     "  opacity: %.2f;\n"
     "}\n\n",
     config->outer_border_radius,
-    // Handle empty background color with transparency
-    (config->window_background_color && strlen(config->window_background_color) > 0) ? 
-      config->window_background_color : 
-      "rgba(20, 20, 20, ",
-    // Add opacity if using the default color
-    (config->window_background_color && strlen(config->window_background_color) > 0) ? 
-      "" : 
-      g_strdup_printf("%.2f)", config->window_background_opacity),
+    window_background,
     config->outer_border_radius,
     config->outer_border_width,
     config->outer_border_color,
@@ -1254,12 +1711,42 @@ hyprmenu_config_apply_css()
     "  min-height: 1px;\n"
     "}\n\n");
 
-  // Apply CSS
-  GtkCssProvider *provider = gtk_css_provider_new();
-  gtk_css_provider_load_from_data(provider, css->str, css->len);
-  gtk_style_context_add_provider_for_display(gdk_display_get_default(),
-                                            GTK_STYLE_PROVIDER(provider),
-                                            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-  g_object_unref(provider);
-  g_string_free(css, TRUE);
+  return css;
+}
+
+void
+hyprmenu_config_apply_css()
+{
+  if (!config) return;
+  
+  guint64 hash = style_hash();
+  if (css_provider && hash == css_hash) {
+    return;
+  }
+  
+  if (!css_provider) {
+    css_provider = gtk_css_provider_new();
+    gtk_style_context_add_provider_for_display(gdk_display_get_default(),
+                                              GTK_STYLE_PROVIDER(css_provider),
+                                              GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+  }
+  
+  // Reuse the stylesheet cached for this style when there is one
+  g_autofree char *path = css_cache_path();
+  g_autofree char *header = css_cache_header(hash);
+  g_autofree char *cached = NULL;
+  gsize cached_len = 0;
+  if (g_file_get_contents(path, &cached, &cached_len, NULL) &&
+      g_str_has_prefix(cached, header)) {
+    gtk_css_provider_load_from_data(css_provider, cached, cached_len);
+    css_hash = hash;
+    return;
+  }
+  
+  GString *css = generate_css();
+  g_string_prepend(css, header);
+  gtk_css_provider_load_from_data(css_provider, css->str, css->len);
+  css_hash = hash;
+  
+  write_cache_async(g_steal_pointer(&path), g_string_free_to_bytes(css));
 } 
\ No newline at end of file
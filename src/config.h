@@ -14,6 +14,25 @@ typedef enum {
   POSITION_CENTER
 } HyprMenuPosition;
 
+/* Parts of the config, each covering one or more key file groups */
+typedef enum {
+  HYPRMENU_CONFIG_LAYOUT        = 1 << 0,  // [Layout]: size and position
+  HYPRMENU_CONFIG_WINDOW        = 1 << 1,  // [Window], [Border], [Transparency], [Hyprland]
+  HYPRMENU_CONFIG_GRID          = 1 << 2,  // [Grid]
+  HYPRMENU_CONFIG_LIST          = 1 << 3,  // [List]
+  HYPRMENU_CONFIG_APP_ENTRY     = 1 << 4,  // [AppEntry]
+  HYPRMENU_CONFIG_CATEGORY      = 1 << 5,  // [Category]
+  HYPRMENU_CONFIG_SEARCH        = 1 << 6,  // [Search]
+  HYPRMENU_CONFIG_SYSTEM_BUTTON = 1 << 7,  // [SystemButton]
+  HYPRMENU_CONFIG_BEHAVIOR      = 1 << 8   // [Behavior]
+} HyprMenuConfigSection;
+
+/* Sections feeding the generated CSS */
+#define HYPRMENU_CONFIG_STYLE_SECTIONS \
+  (HYPRMENU_CONFIG_LAYOUT | HYPRMENU_CONFIG_WINDOW | HYPRMENU_CONFIG_GRID | \
+   HYPRMENU_CONFIG_LIST | HYPRMENU_CONFIG_APP_ENTRY | HYPRMENU_CONFIG_CATEGORY | \
+   HYPRMENU_CONFIG_SEARCH | HYPRMENU_CONFIG_SYSTEM_BUTTON)
+
 typedef struct _HyprMenuConfig {
   // Window layout
   int window_width;
@@ -32,8 +51,6 @@ typedef struct _HyprMenuConfig {
 
   // Window options
   int window_corner_radius;
-  int window_border_width;
-  char *window_border_color;
   double window_background_opacity;
   double window_background_blur;
   char *window_background_color;
@@ -169,6 +186,7 @@ typedef struct _HyprMenuConfig {
   int blur_strength;
   double opacity;
   int max_recent_apps;  // Maximum number of recent apps to show
+  int max_search_results;  // Maximum number of search results to show
   
   // Hyprland-specific settings
   gboolean use_hyprland_corner_fix;
@@ -182,8 +200,49 @@ extern HyprMenuConfig *config;
 gboolean hyprmenu_config_init();
 void hyprmenu_config_free();
 gboolean hyprmenu_config_load();
+// Writes the config only if it has unsaved changes
 gboolean hyprmenu_config_save();
+// Writes the config unconditionally and logs failures; error may be NULL
 gboolean hyprmenu_config_save_with_error(GError **error);
+
+/**
+ * Save the config without blocking if it changed since it was loaded or
+ * last written: the key file is built right away and written on a worker
+ * thread. Saves requested while one is being written are coalesced into
+ * a single write of the latest config.
+ */
+void hyprmenu_config_save_async();
+
+/**
+ * Note that config fields were changed. The config is saved in the
+ * background once no further changes come in for a short while;
+ * hyprmenu_config_save() writes pending changes right away.
+ */
+void hyprmenu_config_mark_dirty();
+
+/**
+ * Re-read the config file after it changed on disk. Nothing is reloaded
+ * when the file holds what HyprMenu last wrote. Changes of its own that
+ * are not written yet are kept for the keys they touched and written
+ * along with the edit. While a write is in flight the reload waits for
+ * it and is reported through the reload function instead.
+ * @return The sections whose values changed, 0 if none did or the reload
+ *         was deferred
+ */
+HyprMenuConfigSection hyprmenu_config_reload();
+
+/**
+ * Called with the changed sections when a reload deferred by
+ * hyprmenu_config_reload() has run
+ */
+typedef void (*HyprMenuConfigReloadFunc) (HyprMenuConfigSection changed, gpointer user_data);
+
+/**
+ * Set the function told about deferred reloads
+ * @param func The function, or NULL to unset it
+ * @param user_data Data for the function
+ */
+void hyprmenu_config_set_reload_func(HyprMenuConfigReloadFunc func, gpointer user_data);
 void hyprmenu_config_apply_css();
 
 // Position utility functions
@@ -0,0 +1,486 @@
+#include "launch_history.h"
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <math.h>
+#include <string.h>
+
+/*
+ * History file layout (native endianness, every section 8-byte aligned):
+ *
+ *   HistoryHeader
+ *   HistoryEntryRecord[n_entries]  one per app, as of the last compaction
+ *   char strings[strings_size]     NUL-terminated desktop IDs, NUL padded
+ *   launch log                     per launch since: a HistoryLaunchRecord,
+ *                                  then the desktop ID, NUL padded
+ *
+ * A launch only appends to the log. Loading maps the file, takes the
+ * entries as they are and replays the log on top of them.
+ */
+
+#define HISTORY_MAGIC "HMLNCHS"
+#define HISTORY_VERSION 1
+
+/* A launch counts half as much after a week */
+#define HALF_LIFE_SECONDS (7 * 24 * 60 * 60)
+
+/* Apps decayed below this are forgotten when compacting */
+#define MIN_SCORE 0.01
+
+/* Launches in the log that make recording or loading compact the file */
+#define COMPACT_THRESHOLD 64
+
+typedef struct {
+  char magic[8];
+  guint32 version;
+  guint32 n_entries;
+  guint32 strings_size;
+  guint32 padding;
+} HistoryHeader;
+
+typedef struct {
+  gint64 last_used;   /* Seconds since the epoch */
+  double score;       /* Decayed score as of last_used */
+  guint32 id;         /* Offset into strings */
+  guint32 count;      /* Launches ever recorded */
+} HistoryEntryRecord;
+
+typedef struct {
+  gint64 time;
+  guint32 id_len;     /* Bytes of ID that follow, without padding */
+  guint32 padding;
+} HistoryLaunchRecord;
+
+G_STATIC_ASSERT(sizeof(HistoryHeader) % 8 == 0);
+G_STATIC_ASSERT(sizeof(HistoryEntryRecord) % 8 == 0);
+G_STATIC_ASSERT(sizeof(HistoryLaunchRecord) % 8 == 0);
+
+typedef struct {
+  double score;
+  gint64 last_used;
+  guint32 count;
+} HistoryEntry;
+
+struct _HyprMenuLaunchHistory {
+  char *path;
+  GHashTable *entries;     /* Interned desktop ID -> HistoryEntry */
+  gboolean file_valid;     /* The file exists with a header to append to */
+  guint n_logged;          /* Launch records after the entries */
+  GByteArray *compacting;  /* Set while compacting: launches the new file still needs */
+  guint n_compacting;
+};
+
+#define PAD8(n) (((n) + 7) & ~(gsize)7)
+
+static double
+decayed_score(const HistoryEntry *entry, gint64 now)
+{
+  gint64 age = MAX(now - entry->last_used, 0);
+  return entry->score * exp2(-(double)age / HALF_LIFE_SECONDS);
+}
+
+static void
+apply_launch(HyprMenuLaunchHistory *self, const char *id, gint64 time)
+{
+  const char *key = g_intern_string(id);
+  HistoryEntry *entry = g_hash_table_lookup(self->entries, key);
+
+  if (!entry) {
+    entry = g_new0(HistoryEntry, 1);
+    entry->last_used = time;
+    g_hash_table_insert(self->entries, (gpointer)key, entry);
+  }
+
+  entry->score = decayed_score(entry, time) + 1.0;
+  entry->last_used = MAX(entry->last_used, time);
+  entry->count++;
+}
+
+static gboolean
+load_file(HyprMenuLaunchHistory *self)
+{
+  GError *error = NULL;
+  GMappedFile *mapped = g_mapped_file_new(self->path, FALSE, &error);
+
+  if (!mapped) {
+    if (!g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT)) {
+      g_warning("Failed to open launch history: %s", error->message);
+    }
+    g_error_free(error);
+    return FALSE;
+  }
+
+  const char *data = g_mapped_file_get_contents(mapped);
+  gsize length = g_mapped_file_get_length(mapped);
+  const HistoryHeader *header = (const HistoryHeader *)data;
+
+  if (!data || length < sizeof(HistoryHeader) ||
+      memcmp(header->magic, HISTORY_MAGIC, sizeof(header->magic)) != 0 ||
+      header->version != HISTORY_VERSION ||
+      header->strings_size % 8 != 0) {
+    g_print("Launch history is invalid, starting over\n");
+    g_mapped_file_unref(mapped);
+    return FALSE;
+  }
+
+  guint64 strings_offset = sizeof(HistoryHeader) + (guint64)header->n_entries * sizeof(HistoryEntryRecord);
+  guint64 log_offset = strings_offset + header->strings_size;
+
+  /* Padding keeps the last string byte NUL, so every offset below the
+   * end lands on a terminated string */
+  if (log_offset > length ||
+      (header->n_entries > 0 && (header->strings_size == 0 || data[log_offset - 1] != '\0'))) {
+    g_print("Launch history is invalid, starting over\n");
+    g_mapped_file_unref(mapped);
+    return FALSE;
+  }
+
+  const HistoryEntryRecord *records = (const HistoryEntryRecord *)(data + sizeof(HistoryHeader));
+  const char *strings = data + strings_offset;
+
+  for (guint32 i = 0; i < header->n_entries; i++) {
+    if (records[i].id >= header->strings_size || !strings[records[i].id]) {
+      continue;
+    }
+
+    HistoryEntry *entry = g_new(HistoryEntry, 1);
+    entry->score = records[i].score;
+    entry->last_used = records[i].last_used;
+    entry->count = records[i].count;
+    g_hash_table_replace(self->entries, (gpointer)g_intern_string(strings + records[i].id), entry);
+  }
+
+  gsize offset = log_offset;
+  while (offset + sizeof(HistoryLaunchRecord) <= length) {
+    const HistoryLaunchRecord *launch = (const HistoryLaunchRecord *)(data + offset);
+    gsize size = sizeof(HistoryLaunchRecord) + PAD8((gsize)launch->id_len);
+
+    if (launch->id_len == 0 || size > length - offset) {
+      break;
+    }
+
+    char *id = g_strndup(data + offset + sizeof(HistoryLaunchRecord), launch->id_len);
+    apply_launch(self, id, launch->time);
+    g_free(id);
+
+    self->n_logged++;
+    offset += size;
+  }
+
+  g_mapped_file_unref(mapped);
+
+  /* A launch cut short by a crash would hide every one appended after
+   * it; rewrite the file on the next launch instead */
+  if (offset != length) {
+    g_print("Launch history has a truncated record, rewriting it on next launch\n");
+    return FALSE;
+  }
+
+  g_print("Launch history loaded: %u apps, %u logged launches\n",
+          g_hash_table_size(self->entries), self->n_logged);
+  return TRUE;
+}
+
+/* Serialize the entries, forgetting those that have decayed away */
+static GBytes *
+serialize(HyprMenuLaunchHistory *self)
+{
+  gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+  GByteArray *strings = g_byte_array_new();
+  GArray *records = g_array_new(FALSE, TRUE, sizeof(HistoryEntryRecord));
+  HistoryHeader header = { .version = HISTORY_VERSION };
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_hash_table_iter_init(&iter, self->entries);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    HistoryEntry *entry = value;
+
+    if (decayed_score(entry, now) < MIN_SCORE) {
+      g_hash_table_iter_remove(&iter);
+      continue;
+    }
+
+    HistoryEntryRecord record = {
+      .last_used = entry->last_used,
+      .score = entry->score,
+      .id = strings->len,
+      .count = entry->count,
+    };
+    g_array_append_val(records, record);
+    g_byte_array_append(strings, key, strlen(key) + 1);
+  }
+
+  static const guint8 zeros[8] = { 0 };
+  g_byte_array_append(strings, zeros, PAD8(strings->len) - strings->len);
+
+  memcpy(header.magic, HISTORY_MAGIC, sizeof(header.magic));
+  header.n_entries = records->len;
+  header.strings_size = strings->len;
+
+  GByteArray *data = g_byte_array_sized_new(sizeof(header) +
+                                            records->len * sizeof(HistoryEntryRecord) +
+                                            strings->len);
+  g_byte_array_append(data, (const guint8 *)&header, sizeof(header));
+  g_byte_array_append(data, (const guint8 *)records->data, records->len * sizeof(HistoryEntryRecord));
+  g_byte_array_append(data, strings->data, strings->len);
+
+  g_array_unref(records);
+  g_byte_array_unref(strings);
+  return g_byte_array_free_to_bytes(data);
+}
+
+static gboolean
+write_file(const char *path, GBytes *bytes, GError **error)
+{
+  char *dir = g_path_get_dirname(path);
+  int result = g_mkdir_with_parents(dir, 0755);
+  g_free(dir);
+
+  if (result != 0) {
+    g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(errno),
+                "Failed to create directory for %s", path);
+    return FALSE;
+  }
+
+  gsize size;
+  const char *data = g_bytes_get_data(bytes, &size);
+  return g_file_set_contents(path, data, size, error);
+}
+
+/* Rewrite the whole file from the entries */
+static void
+write_snapshot(HyprMenuLaunchHistory *self)
+{
+  GBytes *bytes = serialize(self);
+  GError *error = NULL;
+
+  if (write_file(self->path, bytes, &error)) {
+    self->file_valid = TRUE;
+    self->n_logged = 0;
+  } else {
+    g_warning("Failed to write launch history: %s", error->message);
+    g_error_free(error);
+  }
+
+  g_bytes_unref(bytes);
+}
+
+static gboolean
+append_to_file(const char *path, const guint8 *data, gsize size)
+{
+  int fd = g_open(path, O_WRONLY | O_APPEND, 0);
+  if (fd < 0) {
+    return FALSE;
+  }
+
+  gboolean ok = TRUE;
+  while (size > 0) {
+    gssize written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ok = FALSE;
+      break;
+    }
+    data += written;
+    size -= written;
+  }
+
+  return g_close(fd, NULL) && ok;
+}
+
+typedef struct {
+  char *path;     /* Temporary file next to the history */
+  GBytes *bytes;
+} CompactJob;
+
+static void
+compact_job_free(gpointer data)
+{
+  CompactJob *job = data;
+  g_free(job->path);
+  g_bytes_unref(job->bytes);
+  g_free(job);
+}
+
+static void
+compact_thread(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable)
+{
+  (void)source_object;
+  (void)cancellable;
+
+  CompactJob *job = task_data;
+  GError *error = NULL;
+
+  if (write_file(job->path, job->bytes, &error)) {
+    g_task_return_boolean(task, TRUE);
+  } else {
+    g_task_return_error(task, error);
+  }
+}
+
+static void
+on_compact_done(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+  (void)source;
+
+  HyprMenuLaunchHistory *self = user_data;
+  CompactJob *job = g_task_get_task_data(G_TASK(result));
+  GError *error = NULL;
+
+  /* Launches recorded meanwhile went to the old file; carry them over
+   * before the new one replaces it */
+  if (!g_task_propagate_boolean(G_TASK(result), &error) ||
+      (self->compacting->len > 0 &&
+       !append_to_file(job->path, self->compacting->data, self->compacting->len))) {
+    g_warning("Failed to compact launch history: %s", error ? error->message : g_strerror(errno));
+    g_clear_error(&error);
+    g_unlink(job->path);
+  } else if (g_rename(job->path, self->path) != 0) {
+    g_warning("Failed to replace launch history: %s", g_strerror(errno));
+    g_unlink(job->path);
+  } else {
+    g_print("Launch history compacted: %u apps\n", g_hash_table_size(self->entries));
+    self->n_logged = self->n_compacting;
+  }
+
+  g_clear_pointer(&self->compacting, g_byte_array_unref);
+  self->n_compacting = 0;
+}
+
+static void
+start_compaction(HyprMenuLaunchHistory *self)
+{
+  CompactJob *job = g_new(CompactJob, 1);
+  job->path = g_strconcat(self->path, ".new", NULL);
+  job->bytes = serialize(self);
+
+  self->compacting = g_byte_array_new();
+  self->n_compacting = 0;
+
+  GTask *task = g_task_new(NULL, NULL, on_compact_done, self);
+  g_task_set_source_tag(task, start_compaction);
+  g_task_set_task_data(task, job, compact_job_free);
+  g_task_run_in_thread(task, compact_thread);
+  g_object_unref(task);
+}
+
+HyprMenuLaunchHistory *
+hyprmenu_launch_history_get_default(void)
+{
+  static HyprMenuLaunchHistory *history = NULL;
+
+  if (history) {
+    return history;
+  }
+
+  history = g_new0(HyprMenuLaunchHistory, 1);
+  history->path = g_build_filename(g_get_user_data_dir(), "hyprmenu", "launches.bin", NULL);
+  history->entries = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+  history->file_valid = load_file(history);
+
+  if (history->file_valid && history->n_logged >= COMPACT_THRESHOLD) {
+    start_compaction(history);
+  }
+
+  return history;
+}
+
+void
+hyprmenu_launch_history_record(HyprMenuLaunchHistory *self, const char *id)
+{
+  g_return_if_fail(self != NULL);
+  g_return_if_fail(id != NULL && *id);
+
+  gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+  apply_launch(self, id, now);
+
+  HistoryLaunchRecord launch = { .time = now, .id_len = strlen(id) };
+  static const guint8 zeros[8] = { 0 };
+  GByteArray *bytes = g_byte_array_sized_new(sizeof(launch) + PAD8(launch.id_len));
+  g_byte_array_append(bytes, (const guint8 *)&launch, sizeof(launch));
+  g_byte_array_append(bytes, (const guint8 *)id, launch.id_len);
+  g_byte_array_append(bytes, zeros, PAD8(launch.id_len) - launch.id_len);
+
+  if (self->compacting) {
+    g_byte_array_append(self->compacting, bytes->data, bytes->len);
+    self->n_compacting++;
+  }
+
+  /* A missing or damaged file is rewritten whole, this launch included */
+  if (self->file_valid && append_to_file(self->path, bytes->data, bytes->len)) {
+    self->n_logged++;
+    /* A daemon never restarts, so the log must not wait for startup */
+    if (self->n_logged >= COMPACT_THRESHOLD && !self->compacting) {
+      start_compaction(self);
+    }
+  } else {
+    write_snapshot(self);
+  }
+
+  g_byte_array_unref(bytes);
+}
+
+double
+hyprmenu_launch_history_get_score(HyprMenuLaunchHistory *self, const char *id)
+{
+  g_return_val_if_fail(self != NULL, 0);
+
+  if (!id) {
+    return 0;
+  }
+
+  /* Keys are interned, so an ID that was never interned can't be present.
+   * Don't intern it here: lookups must not grow the string table. */
+  GQuark quark = g_quark_try_string(id);
+  if (!quark) {
+    return 0;
+  }
+
+  HistoryEntry *entry = g_hash_table_lookup(self->entries, g_quark_to_string(quark));
+  return entry ? decayed_score(entry, g_get_real_time() / G_USEC_PER_SEC) : 0;
+}
+
+typedef struct {
+  const char *id;
+  double score;
+} ScoredId;
+
+static int
+compare_scored_ids(gconstpointer a, gconstpointer b)
+{
+  const ScoredId *sa = a;
+  const ScoredId *sb = b;
+
+  return (sa->score < sb->score) - (sa->score > sb->score);
+}
+
+GPtrArray *
+hyprmenu_launch_history_get_top(HyprMenuLaunchHistory *self, guint limit)
+{
+  g_return_val_if_fail(self != NULL, NULL);
+
+  gint64 now = g_get_real_time() / G_USEC_PER_SEC;
+  GArray *scored = g_array_sized_new(FALSE, FALSE, sizeof(ScoredId), g_hash_table_size(self->entries));
+  GHashTableIter iter;
+  gpointer key, value;
+
+  g_hash_table_iter_init(&iter, self->entries);
+  while (g_hash_table_iter_next(&iter, &key, &value)) {
+    ScoredId scored_id = { key, decayed_score(value, now) };
+    g_array_append_val(scored, scored_id);
+  }
+  g_array_sort(scored, compare_scored_ids);
+
+  GPtrArray *top = g_ptr_array_sized_new(MIN(scored->len, limit));
+  for (guint i = 0; i < scored->len && i < limit; i++) {
+    g_ptr_array_add(top, (gpointer)g_array_index(scored, ScoredId, i).id);
+  }
+
+  g_array_unref(scored);
+  return top;
+}
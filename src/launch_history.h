@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _HyprMenuLaunchHistory HyprMenuLaunchHistory;
+
+/**
+ * Get the launch history, loading it on first use. The history file in
+ * $XDG_DATA_HOME/hyprmenu is memory-mapped and read without parsing
+ * any text; launches since it was last compacted are replayed from
+ * records appended to its end.
+ * @return The history, owned by HyprMenu
+ */
+HyprMenuLaunchHistory* hyprmenu_launch_history_get_default(void);
+
+/**
+ * Record a launch by appending one record to the history file. Once
+ * enough launches have piled up, this starts compacting the file on a
+ * worker thread; launches recorded meanwhile are carried over.
+ * @param self The history
+ * @param id Desktop file ID of the launched app
+ */
+void hyprmenu_launch_history_record(HyprMenuLaunchHistory* self, const char* id);
+
+/**
+ * Get how frequently and recently an app was launched: every launch
+ * counts 1, halving with each week since
+ * @param self The history
+ * @param id Desktop file ID
+ * @return The score, 0 for apps never launched
+ */
+double hyprmenu_launch_history_get_score(HyprMenuLaunchHistory* self, const char* id);
+
+/**
+ * Get the apps with the highest scores
+ * @param self The history
+ * @param limit Maximum number of apps
+ * @return Array of interned desktop IDs, best first; free with g_ptr_array_unref()
+ */
+GPtrArray* hyprmenu_launch_history_get_top(HyprMenuLaunchHistory* self, guint limit);
+
+G_END_DECLS
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <gtk/gtk.h>
-#include <gio/gdesktopappinfo.h>
+#include "app_item.h"
 
 G_BEGIN_DECLS
 
@@ -29,12 +29,12 @@ G_DECLARE_FINAL_TYPE(HyprMenuListView, hyprmenu_list_view, HYPRMENU, LIST_VIEW,
 GtkWidget* hyprmenu_list_view_new(void);
 
 /**
- * Add an application to the list view
+ * Show the apps of a model; rows follow the model's items-changed signal.
+ * Searching is done by filtering the model.
  * @param self The list view instance
- * @param app_info The application info to add
- * @return TRUE if the app was added successfully, FALSE otherwise
+ * @param model A GListModel of HyprMenuAppItem, or NULL
  */
-gboolean hyprmenu_list_view_add_app(HyprMenuListView* self, GDesktopAppInfo* app_info);
+void hyprmenu_list_view_set_model(HyprMenuListView* self, GListModel* model);
 
 /**
  * Clear all applications from the list view
@@ -42,14 +42,6 @@ gboolean hyprmenu_list_view_add_app(HyprMenuListView* self, GDesktopAppInfo* app
  */
 void hyprmenu_list_view_clear(HyprMenuListView* self);
 
-/**
- * Filter applications based on search text
- * @param self The list view instance
- * @param text The search text to filter by
- * @return TRUE if the filter was applied successfully, FALSE otherwise
- */
-gboolean hyprmenu_list_view_filter(HyprMenuListView* self, const char* text);
-
 /**
  * Set whether to show application descriptions
  * @param self The list view instance
@@ -14,11 +14,37 @@ setup_debug_logging(void)
   }
 }
 
+/* Set by --daemon in the primary instance: keep the application alive and
+ * hide the menu instead of quitting, so later invocations only re-present
+ * the already built window. */
+static gboolean daemon_mode = FALSE;
+
+/* The activation that follows a --daemon launch only prebuilds the menu */
+static gboolean daemon_startup = FALSE;
+
+static HyprMenuWindow *
+find_menu_window(GtkApplication *app)
+{
+  for (GList *l = gtk_application_get_windows(app); l != NULL; l = l->next) {
+    if (HYPRMENU_IS_WINDOW(l->data)) {
+      return HYPRMENU_WINDOW(l->data);
+    }
+  }
+  return NULL;
+}
+
 static void
 on_activate(GtkApplication *app)
 {
   g_message("Activating application");
   
+  // A resident menu already exists: just toggle it
+  HyprMenuWindow *existing = find_menu_window(app);
+  if (existing) {
+    hyprmenu_window_toggle(existing);
+    return;
+  }
+  
   // Load config first
   if (!hyprmenu_config_load()) {
     g_critical("Failed to load configuration");
@@ -32,13 +58,52 @@ on_activate(GtkApplication *app)
     g_critical("Failed to create window");
     return;
   }
+  hyprmenu_window_set_resident(window, daemon_mode);
   g_message("Window created successfully");
   
+  if (daemon_startup) {
+    // Build the widget tree now so the first toggle is instant
+    daemon_startup = FALSE;
+    hyprmenu_window_prepare(window);
+    g_message("Daemon started, menu prepared");
+    return;
+  }
+  
   // Show window
   hyprmenu_window_show(window);
   g_message("Window shown");
 }
 
+static void
+on_toggle_action(GSimpleAction *action,
+                 GVariant      *parameter,
+                 gpointer       user_data)
+{
+  (void)action;
+  (void)parameter;
+  
+  on_activate(GTK_APPLICATION(user_data));
+}
+
+static gint
+on_handle_local_options(GApplication *app,
+                        GVariantDict *options,
+                        gpointer      user_data)
+{
+  (void)user_data;
+  
+  if (g_variant_dict_contains(options, "daemon") &&
+      !g_application_get_is_remote(app)) {
+    g_message("Running as resident daemon");
+    daemon_mode = TRUE;
+    daemon_startup = TRUE;
+    g_application_hold(app);
+  }
+  
+  // Continue with the default activation
+  return -1;
+}
+
 static void
 on_shutdown(GApplication *app, gpointer user_data)
 {
@@ -62,45 +127,70 @@ main(int argc, char *argv[])
   g_setenv("GDK_BACKEND", "wayland", TRUE);
   g_message("Set Wayland backend");
 
-  /* Initialize GTK */
-  if (!gtk_init_check()) {
-    g_critical("Failed to initialize GTK");
-    return 1;
-  }
-  g_message("GTK initialized");
-
-  /* Verify we're running under Wayland */
-  GdkDisplay *display = gdk_display_get_default();
-  if (!display) {
-    g_critical("No display found");
-    return 1;
-  }
-  
-  if (!GDK_IS_WAYLAND_DISPLAY(display)) {
-    g_critical("Not running under Wayland");
-    return 1;
-  }
-  g_message("Confirmed running under Wayland");
-
-  /* Check GTK Layer Shell */
-  if (!gtk_layer_is_supported()) {
-    g_critical("GTK Layer Shell is not supported by this compositor");
-    return 1;
-  }
-  g_message("GTK Layer Shell support confirmed");
-  
   // Create application
   GtkApplication *app = gtk_application_new("org.hyprmenu.app", G_APPLICATION_DEFAULT_FLAGS);
+  g_application_add_main_option(G_APPLICATION(app), "daemon", 'd',
+                                G_OPTION_FLAG_NONE, G_OPTION_ARG_NONE,
+                                "Stay resident and toggle the menu on each invocation",
+                                NULL);
+  g_signal_connect(app, "handle-local-options", G_CALLBACK(on_handle_local_options), NULL);
   g_signal_connect(app, "activate", G_CALLBACK(on_activate), NULL);
   g_signal_connect(app, "shutdown", G_CALLBACK(on_shutdown), NULL);
+  
+  /* Exported over D-Bus as org.gtk.Actions "toggle" */
+  GSimpleAction *toggle_action = g_simple_action_new("toggle", NULL);
+  g_signal_connect(toggle_action, "activate", G_CALLBACK(on_toggle_action), app);
+  g_action_map_add_action(G_ACTION_MAP(app), G_ACTION(toggle_action));
+  g_object_unref(toggle_action);
   g_message("Application created");
   
-  /* Initialize configuration */
-  if (!hyprmenu_config_init()) {
-    g_critical("Failed to initialize configuration");
+  /* Register early so a second invocation can hand over to the running
+   * instance without initializing GTK or loading the configuration */
+  GError *error = NULL;
+  if (!g_application_register(G_APPLICATION(app), NULL, &error)) {
+    g_critical("Failed to register application: %s", error->message);
+    g_error_free(error);
+    g_object_unref(app);
     return 1;
   }
-  g_message("Configuration initialized");
+  
+  if (!g_application_get_is_remote(G_APPLICATION(app))) {
+    /* Initialize GTK */
+    if (!gtk_init_check()) {
+      g_critical("Failed to initialize GTK");
+      return 1;
+    }
+    g_message("GTK initialized");
+
+    /* Verify we're running under Wayland */
+    GdkDisplay *display = gdk_display_get_default();
+    if (!display) {
+      g_critical("No display found");
+      return 1;
+    }
+    
+    if (!GDK_IS_WAYLAND_DISPLAY(display)) {
+      g_critical("Not running under Wayland");
+      return 1;
+    }
+    g_message("Confirmed running under Wayland");
+
+    /* Check GTK Layer Shell */
+    if (!gtk_layer_is_supported()) {
+      g_critical("GTK Layer Shell is not supported by this compositor");
+      return 1;
+    }
+    g_message("GTK Layer Shell support confirmed");
+    
+    /* Initialize configuration */
+    if (!hyprmenu_config_init()) {
+      g_critical("Failed to initialize configuration");
+      return 1;
+    }
+    g_message("Configuration initialized");
+  } else {
+    g_message("Another instance is running, forwarding activation");
+  }
   
   // Run application
   g_message("Running application");
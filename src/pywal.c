@@ -0,0 +1,160 @@
+#include "pywal.h"
+#include "config.h"
+#include <string.h>
+
+// Global pywal color instance
+PywalColors pywal_colors;
+
+/* Delay between the last change to colors.json and reloading it */
+#define PYWAL_RELOAD_DELAY_MS 100
+
+static GtkCssProvider *palette_provider = NULL;
+static GFileMonitor *palette_monitor = NULL;
+static guint reload_source_id = 0;
+
+static char *
+colors_json_path(void)
+{
+  return g_build_filename(g_get_user_cache_dir(), "wal", "colors.json", NULL);
+}
+
+/* Find "key": "#hex" in colors.json. The file is a flat set of string
+ * values, each key appearing once, so no JSON parser is needed; only
+ * hex colors are taken so nothing else can end up in the stylesheet. */
+static char *
+find_color(const char *json, const char *key)
+{
+  g_autofree char *quoted = g_strdup_printf("\"%s\"", key);
+  const char *p = strstr(json, quoted);
+  if (!p) {
+    return NULL;
+  }
+  
+  p += strlen(quoted);
+  while (g_ascii_isspace(*p)) p++;
+  if (*p++ != ':') {
+    return NULL;
+  }
+  while (g_ascii_isspace(*p)) p++;
+  if (*p++ != '"' || *p != '#') {
+    return NULL;
+  }
+  
+  const char *end = p + 1;
+  while (g_ascii_isxdigit(*end)) end++;
+  gsize digits = end - p - 1;
+  if (*end != '"' || (digits != 3 && digits != 6 && digits != 8)) {
+    return NULL;
+  }
+  
+  return g_strndup(p, end - p);
+}
+
+static void
+clear_colors(void)
+{
+  for (int i = 0; i < PYWAL_COLOR_COUNT; i++) {
+    g_clear_pointer(&pywal_colors.colors[i], g_free);
+  }
+  g_clear_pointer(&pywal_colors.special_background, g_free);
+  g_clear_pointer(&pywal_colors.special_foreground, g_free);
+  g_clear_pointer(&pywal_colors.special_cursor, g_free);
+}
+
+static void
+append_color(GString *css, const char *name, const char *value)
+{
+  if (value) {
+    g_string_append_printf(css, "@define-color %s %s;\n", name, value);
+  }
+}
+
+/* Parse colors.json and swap the palette stylesheet; a missing file
+ * leaves the palette empty */
+static void
+load_palette(void)
+{
+  g_autofree char *path = colors_json_path();
+  g_autofree char *json = NULL;
+  
+  clear_colors();
+  if (g_file_get_contents(path, &json, NULL, NULL)) {
+    for (int i = 0; i < PYWAL_COLOR_COUNT; i++) {
+      char key[16];
+      g_snprintf(key, sizeof key, "color%d", i);
+      pywal_colors.colors[i] = find_color(json, key);
+    }
+    pywal_colors.special_background = find_color(json, "background");
+    pywal_colors.special_foreground = find_color(json, "foreground");
+    pywal_colors.special_cursor = find_color(json, "cursor");
+  }
+  
+  GString *css = g_string_new("");
+  for (int i = 0; i < PYWAL_COLOR_COUNT; i++) {
+    char name[16];
+    g_snprintf(name, sizeof name, "color%d", i);
+    append_color(css, name, pywal_colors.colors[i]);
+  }
+  append_color(css, "background", pywal_colors.special_background);
+  append_color(css, "foreground", pywal_colors.special_foreground);
+  append_color(css, "cursor", pywal_colors.special_cursor);
+  
+  gtk_css_provider_load_from_data(palette_provider, css->str, css->len);
+  g_print("Loaded pywal palette from %s (%zu bytes of CSS)\n", path, css->len);
+  g_string_free(css, TRUE);
+}
+
+static gboolean
+reload_palette(gpointer user_data)
+{
+  (void)user_data;
+  
+  reload_source_id = 0;
+  load_palette();
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_colors_changed(GFileMonitor      *monitor,
+                  GFile             *file,
+                  GFile             *other_file,
+                  GFileMonitorEvent  event_type,
+                  gpointer           user_data)
+{
+  (void)monitor;
+  (void)file;
+  (void)other_file;
+  (void)user_data;
+  
+  if (event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED) {
+    return;
+  }
+  
+  // pywal rewrites all its cache files at once; reload when it is done
+  if (reload_source_id) {
+    g_source_remove(reload_source_id);
+  }
+  reload_source_id = g_timeout_add(PYWAL_RELOAD_DELAY_MS, reload_palette, NULL);
+}
+
+void
+hyprmenu_pywal_init(void)
+{
+  if (palette_provider) {
+    return;
+  }
+  
+  palette_provider = gtk_css_provider_new();
+  gtk_style_context_add_provider_for_display(gdk_display_get_default(),
+                                            GTK_STYLE_PROVIDER(palette_provider),
+                                            GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+  load_palette();
+  
+  g_autofree char *path = colors_json_path();
+  GFile *file = g_file_new_for_path(path);
+  palette_monitor = g_file_monitor_file(file, G_FILE_MONITOR_WATCH_MOVES, NULL, NULL);
+  if (palette_monitor) {
+    g_signal_connect(palette_monitor, "changed", G_CALLBACK(on_colors_changed), NULL);
+  }
+  g_object_unref(file);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * Start following the pywal palette in $XDG_CACHE_HOME/wal/colors.json.
+ * The palette is parsed into pywal_colors and defined as the named CSS
+ * colors @color0 to @color15, @background, @foreground and @cursor in a
+ * provider of its own, which config colors can reference. When pywal
+ * writes a new palette only that provider is reloaded, restyling the
+ * menu without regenerating the config CSS or rebuilding widgets.
+ * Calling this again does nothing.
+ */
+void hyprmenu_pywal_init(void);
+
+G_END_DECLS
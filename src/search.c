@@ -0,0 +1,822 @@
+#include "search.h"
+#include <math.h>
+#include <string.h>
+
+static gboolean
+is_ascii (const char *text)
+{
+  for (const guchar *p = (const guchar *)text; *p; p++) {
+    if (*p >= 0x80) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+char *
+hyprmenu_search_fold (const char *text)
+{
+  if (!text || !g_utf8_validate (text, -1, NULL)) {
+    return g_strdup ("");
+  }
+
+  /* Most desktop entries are plain ASCII, where folding is lowercasing */
+  if (is_ascii (text)) {
+    return g_ascii_strdown (text, -1);
+  }
+
+  char *decomposed = g_utf8_normalize (text, -1, G_NORMALIZE_NFKD);
+  if (!decomposed) {
+    return g_strdup ("");
+  }
+
+  GString *stripped = g_string_sized_new (strlen (decomposed));
+  for (const char *p = decomposed; *p; p = g_utf8_next_char (p)) {
+    gunichar c = g_utf8_get_char (p);
+
+    switch (g_unichar_type (c)) {
+      case G_UNICODE_NON_SPACING_MARK:
+      case G_UNICODE_ENCLOSING_MARK:
+        break;
+      default:
+        g_string_append_unichar (stripped, c);
+        break;
+    }
+  }
+
+  char *folded = g_utf8_casefold (stripped->str, stripped->len);
+  g_string_free (stripped, TRUE);
+  g_free (decomposed);
+  return folded;
+}
+
+/* Bits 0-25 are letters, 26-35 digits; every other byte, UTF-8
+ * sequences included, hashes into the 28 bits above */
+#define MASK_OTHER_FIRST 36
+#define MASK_OTHER_BITS 28
+
+static inline guint64
+byte_mask (guchar c)
+{
+  if (c >= 'a' && c <= 'z') return G_GUINT64_CONSTANT (1) << (c - 'a');
+  if (c >= '0' && c <= '9') return G_GUINT64_CONSTANT (1) << (26 + c - '0');
+  return G_GUINT64_CONSTANT (1) << (MASK_OTHER_FIRST + c % MASK_OTHER_BITS);
+}
+
+guint64
+hyprmenu_search_mask (const char *text)
+{
+  guint64 mask = 0;
+
+  if (!text) {
+    return 0;
+  }
+
+  for (const guchar *p = (const guchar *)text; *p; p++) {
+    mask |= byte_mask (*p);
+  }
+  return mask;
+}
+
+/* Scoring, after fzf's */
+#define SCORE_MATCH 16
+#define SCORE_GAP_START (-3)
+#define SCORE_GAP_EXTENSION (-1)
+#define BONUS_BOUNDARY 8             /* First character of a word */
+#define BONUS_CAMEL 7                /* camelCase hump or start of a number */
+#define BONUS_CONSECUTIVE 4          /* Minimum bonus inside a run of matches */
+#define BONUS_FIRST_CHAR_MULTIPLIER 2
+#define BONUS_PREFIX 16              /* Match starts at the very beginning */
+
+/* Frequently launched apps rank higher by this much per doubling of
+ * their launch score, capped so they cannot beat a far better match */
+#define BONUS_FRECENCY 6
+#define BONUS_FRECENCY_MAX 32
+
+/* Ranking penalties for fields other than the name */
+#define PENALTY_GENERIC_NAME 8
+#define PENALTY_KEYWORDS 12
+#define PENALTY_EXEC 12
+
+/* Descriptions are prose that fuzzy matching would match almost
+ * anything in, so they only match the query as a substring, and then
+ * score no more than a single matched character */
+#define SCORE_DESCRIPTION (SCORE_MATCH / 2)
+
+#define SCORE_NONE G_MININT16
+
+typedef enum {
+  CHAR_NONWORD,
+  CHAR_LOWER,
+  CHAR_UPPER,
+  CHAR_DIGIT,
+} CharClass;
+
+static inline CharClass
+char_class (guchar c)
+{
+  if (c >= 'a' && c <= 'z') return CHAR_LOWER;
+  if (c >= 'A' && c <= 'Z') return CHAR_UPPER;
+  if (c >= '0' && c <= '9') return CHAR_DIGIT;
+  /* Bytes of non-ASCII characters count as letters */
+  if (c >= 0x80) return CHAR_LOWER;
+  return CHAR_NONWORD;
+}
+
+static inline int
+char_bonus (CharClass prev, CharClass cls)
+{
+  if (cls == CHAR_NONWORD) return 0;
+  if (prev == CHAR_NONWORD) return BONUS_BOUNDARY;
+  if (prev == CHAR_LOWER && cls == CHAR_UPPER) return BONUS_CAMEL;
+  if (prev != CHAR_DIGIT && cls == CHAR_DIGIT) return BONUS_CAMEL;
+  return 0;
+}
+
+/* Substring search over folded keys. Both sides are already folded, so
+ * this is a plain byte search and holds for any script. It only serves
+ * queries too long for the fuzzy matcher, which are rare enough that
+ * memchr() to the first byte and memcmp() of the rest is plenty. */
+static const char *
+find_substring (const char *text, gsize text_len, const char *query, gsize query_len)
+{
+  if (query_len > text_len) {
+    return NULL;
+  }
+
+  const char *end = text + text_len - query_len + 1;
+
+  for (const char *p = text; p < end; p++) {
+    p = memchr (p, query[0], end - p);
+    if (!p) {
+      return NULL;
+    }
+    if (memcmp (p + 1, query + 1, query_len - 1) == 0) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+/* Queries too long for the score matrix only match as substrings */
+static gboolean
+match_substring (const char *query, gsize query_len,
+                 const char *text, gsize text_len,
+                 HyprMenuSearchMatch *match)
+{
+  const char *found = find_substring (text, text_len, query, query_len);
+  if (!found) {
+    return FALSE;
+  }
+
+  match->score = SCORE_MATCH * HYPRMENU_SEARCH_MAX_QUERY + (found == text ? BONUS_PREFIX : 0);
+  match->n_positions = 0;
+  return TRUE;
+}
+
+/* The matcher's prefilter: narrow the text to the span between the first
+ * possible start and the last possible end, and reject it early unless
+ * the query is a subsequence of that span. Every query goes through
+ * this for every key on every keystroke, so it comes in vector versions
+ * that look for a byte across a whole block at once. */
+
+typedef gboolean (*SpanFunc) (const char *query, gsize query_len,
+                              const char *text, gsize text_len,
+                              gsize *start, gsize *end);
+
+static gboolean
+span_scalar (const char *query, gsize query_len,
+             const char *text, gsize text_len,
+             gsize *start, gsize *end)
+{
+  const char *first = memchr (text, query[0], text_len);
+  if (!first) {
+    return FALSE;
+  }
+  *start = first - text;
+  *end = text_len;
+  while (*end > *start && text[*end - 1] != query[query_len - 1]) {
+    (*end)--;
+  }
+
+  gsize qi = 0;
+  for (gsize j = *start; j < *end && qi < query_len; j++) {
+    if (text[j] == query[qi]) {
+      qi++;
+    }
+  }
+  return qi == query_len;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define HAVE_X86_DISPATCH 1
+
+/* First and last occurrence of a byte in [begin, end), or NULL */
+typedef const char *(*ByteFunc) (const char *begin, const char *end, char c);
+
+static inline __attribute__ ((always_inline)) gboolean
+span_vector (ByteFunc find, ByteFunc rfind,
+             const char *query, gsize query_len,
+             const char *text, gsize text_len,
+             gsize *start, gsize *end)
+{
+  /* Below one block the vectors never come into play */
+  if (text_len < 16) {
+    return span_scalar (query, query_len, text, text_len, start, end);
+  }
+
+  /* libc's memchr() is vectorized already and quicker to the first byte
+   * over a whole key; the kernels pay off on the short hops after it */
+  const char *text_end = text + text_len;
+  const char *first = memchr (text, query[0], text_len);
+  if (!first) {
+    return FALSE;
+  }
+  const char *last = rfind (first, text_end, query[query_len - 1]);
+  if (!last) {
+    return FALSE;
+  }
+
+  /* Jump to each query byte in turn rather than stepping byte by byte */
+  const char *p = first + 1;
+  for (gsize qi = 1; qi < query_len; qi++) {
+    p = find (p, last + 1, query[qi]);
+    if (!p) {
+      return FALSE;
+    }
+    p++;
+  }
+
+  *start = first - text;
+  *end = last + 1 - text;
+  return TRUE;
+}
+
+__attribute__ ((target ("sse2")))
+static const char *
+find_byte_sse2 (const char *begin, const char *end, char c)
+{
+  const __m128i needle = _mm_set1_epi8 (c);
+  const char *p = begin;
+
+  for (; end - p >= 16; p += 16) {
+    guint mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (needle, _mm_loadu_si128 ((const __m128i *)p)));
+    if (mask) {
+      return p + __builtin_ctz (mask);
+    }
+  }
+  for (; p < end; p++) {
+    if (*p == c) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+__attribute__ ((target ("sse2")))
+static const char *
+rfind_byte_sse2 (const char *begin, const char *end, char c)
+{
+  const __m128i needle = _mm_set1_epi8 (c);
+  const char *p = end;
+
+  for (; p - begin >= 16; p -= 16) {
+    guint mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (needle, _mm_loadu_si128 ((const __m128i *)(p - 16))));
+    if (mask) {
+      return p - 16 + (31 - __builtin_clz (mask));
+    }
+  }
+  while (p > begin) {
+    if (*--p == c) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+__attribute__ ((target ("sse2")))
+static gboolean
+span_sse2 (const char *query, gsize query_len,
+           const char *text, gsize text_len,
+           gsize *start, gsize *end)
+{
+  return span_vector (find_byte_sse2, rfind_byte_sse2, query, query_len, text, text_len, start, end);
+}
+
+/* The AVX2 versions finish with a 16-byte block of their own: calling
+ * into the SSE2 ones would mix VEX and legacy SSE code, and the state
+ * transitions cost more than the vectors save */
+__attribute__ ((target ("avx2")))
+static const char *
+find_byte_avx2 (const char *begin, const char *end, char c)
+{
+  const __m256i needle = _mm256_set1_epi8 (c);
+  const char *p = begin;
+
+  for (; end - p >= 32; p += 32) {
+    guint mask = _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (needle, _mm256_loadu_si256 ((const __m256i *)p)));
+    if (mask) {
+      return p + __builtin_ctz (mask);
+    }
+  }
+  if (end - p >= 16) {
+    guint mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm256_castsi256_si128 (needle),
+                                                    _mm_loadu_si128 ((const __m128i *)p)));
+    if (mask) {
+      return p + __builtin_ctz (mask);
+    }
+    p += 16;
+  }
+  for (; p < end; p++) {
+    if (*p == c) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+__attribute__ ((target ("avx2")))
+static const char *
+rfind_byte_avx2 (const char *begin, const char *end, char c)
+{
+  const __m256i needle = _mm256_set1_epi8 (c);
+  const char *p = end;
+
+  for (; p - begin >= 32; p -= 32) {
+    guint mask = _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (needle, _mm256_loadu_si256 ((const __m256i *)(p - 32))));
+    if (mask) {
+      return p - 32 + (31 - __builtin_clz (mask));
+    }
+  }
+  if (p - begin >= 16) {
+    guint mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm256_castsi256_si128 (needle),
+                                                    _mm_loadu_si128 ((const __m128i *)(p - 16))));
+    if (mask) {
+      return p - 16 + (31 - __builtin_clz (mask));
+    }
+    p -= 16;
+  }
+  while (p > begin) {
+    if (*--p == c) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+__attribute__ ((target ("avx2")))
+static gboolean
+span_avx2 (const char *query, gsize query_len,
+           const char *text, gsize text_len,
+           gsize *start, gsize *end)
+{
+  return span_vector (find_byte_avx2, rfind_byte_avx2, query, query_len, text, text_len, start, end);
+}
+#endif
+
+static SpanFunc
+span_func_for (HyprMenuSearchKernel kernel)
+{
+  switch (kernel) {
+#ifdef HAVE_X86_DISPATCH
+    case HYPRMENU_SEARCH_KERNEL_AVX2:
+      __builtin_cpu_init ();
+      return __builtin_cpu_supports ("avx2") ? span_avx2 : NULL;
+    case HYPRMENU_SEARCH_KERNEL_SSE2:
+      __builtin_cpu_init ();
+      return __builtin_cpu_supports ("sse2") ? span_sse2 : NULL;
+#endif
+    case HYPRMENU_SEARCH_KERNEL_SCALAR:
+      return span_scalar;
+    default:
+      return NULL;
+  }
+}
+
+static HyprMenuSearchKernel current_kernel;
+static SpanFunc span_impl;
+
+/* The best kernel the CPU runs, picked on first use */
+static SpanFunc
+get_span_func (void)
+{
+  static gsize resolved = 0;
+
+  if (g_once_init_enter (&resolved)) {
+    for (current_kernel = HYPRMENU_SEARCH_KERNEL_AVX2;
+         !(span_impl = span_func_for (current_kernel));
+         current_kernel--) {
+    }
+    g_once_init_leave (&resolved, 1);
+  }
+  return span_impl;
+}
+
+HyprMenuSearchKernel
+hyprmenu_search_get_kernel (void)
+{
+  get_span_func ();
+  return current_kernel;
+}
+
+gboolean
+hyprmenu_search_set_kernel (HyprMenuSearchKernel kernel)
+{
+  SpanFunc func = span_func_for (kernel);
+
+  if (!func) {
+    return FALSE;
+  }
+  get_span_func ();
+  current_kernel = kernel;
+  span_impl = func;
+  return TRUE;
+}
+
+gboolean
+hyprmenu_search_match (const char *query, gsize query_len,
+                       const char *text, const char *original,
+                       HyprMenuSearchMatch *match)
+{
+  g_return_val_if_fail (query != NULL && query_len > 0, FALSE);
+
+  if (!text || !*text) {
+    return FALSE;
+  }
+
+  gsize full_len = strlen (text);
+  gsize text_len = MIN (full_len, HYPRMENU_SEARCH_MAX_TEXT);
+  const char *classes = original && strlen (original) == full_len ? original : text;
+
+  if (query_len > HYPRMENU_SEARCH_MAX_QUERY) {
+    return match_substring (query, query_len, text, full_len, match);
+  }
+
+  gsize start, end;
+  if (!get_span_func () (query, query_len, text, text_len, &start, &end)) {
+    return FALSE;
+  }
+
+  gsize width = end - start;
+  gint16 bonus[HYPRMENU_SEARCH_MAX_TEXT];
+  CharClass prev = start > 0 ? char_class (classes[start - 1]) : CHAR_NONWORD;
+  for (gsize j = 0; j < width; j++) {
+    CharClass cls = char_class (classes[start + j]);
+    bonus[j] = char_bonus (prev, cls);
+    prev = cls;
+  }
+
+  /* score[i][j]: best alignment of query[0..i] with query[i] matched at
+   * text[start + j]; from[i][j]: column query[i - 1] was matched at */
+  gint16 score[HYPRMENU_SEARCH_MAX_QUERY][HYPRMENU_SEARCH_MAX_TEXT];
+  gint16 from[HYPRMENU_SEARCH_MAX_QUERY][HYPRMENU_SEARCH_MAX_TEXT];
+
+  for (gsize i = 0; i < query_len; i++) {
+    /* Best predecessor at least two columns back, gap cost included */
+    int gapped = SCORE_NONE;
+    int gapped_from = -1;
+
+    for (gsize j = 0; j < width; j++) {
+      if (i > 0 && j >= 2) {
+        if (gapped != SCORE_NONE) {
+          gapped += SCORE_GAP_EXTENSION;
+        }
+        int opened = score[i - 1][j - 2];
+        if (opened != SCORE_NONE && opened + SCORE_GAP_START > gapped) {
+          gapped = opened + SCORE_GAP_START;
+          gapped_from = j - 2;
+        }
+      }
+
+      score[i][j] = SCORE_NONE;
+      from[i][j] = -1;
+
+      if (text[start + j] != query[i]) {
+        continue;
+      }
+
+      if (i == 0) {
+        score[i][j] = SCORE_MATCH + bonus[j] * BONUS_FIRST_CHAR_MULTIPLIER +
+                      (start + j == 0 ? BONUS_PREFIX : 0);
+        continue;
+      }
+
+      int best = SCORE_NONE;
+      if (j >= 1 && score[i - 1][j - 1] != SCORE_NONE) {
+        best = score[i - 1][j - 1] + SCORE_MATCH + MAX (bonus[j], BONUS_CONSECUTIVE);
+        from[i][j] = j - 1;
+      }
+      if (gapped != SCORE_NONE && gapped + SCORE_MATCH + bonus[j] > best) {
+        best = gapped + SCORE_MATCH + bonus[j];
+        from[i][j] = gapped_from;
+      }
+      score[i][j] = best;
+    }
+  }
+
+  int best = SCORE_NONE;
+  int best_j = -1;
+  for (gsize j = 0; j < width; j++) {
+    if (score[query_len - 1][j] > best) {
+      best = score[query_len - 1][j];
+      best_j = j;
+    }
+  }
+  if (best_j < 0) {
+    return FALSE;
+  }
+
+  match->score = best;
+  match->n_positions = query_len;
+  for (gsize i = query_len; i-- > 0;) {
+    match->positions[i] = start + best_j;
+    best_j = from[i][best_j];
+  }
+
+  return TRUE;
+}
+
+static int
+score_field (const char *query, gsize query_len,
+             const char *key, const char *original, int penalty)
+{
+  HyprMenuSearchMatch match;
+
+  if (!key || !hyprmenu_search_match (query, query_len, key, original, &match)) {
+    return HYPRMENU_SEARCH_NO_MATCH;
+  }
+  return match.score - penalty;
+}
+
+int
+hyprmenu_search_score_item (HyprMenuAppItem *item, const char *query, gsize query_len)
+{
+  int best = score_field (query, query_len, hyprmenu_app_item_get_name_key (item),
+                          hyprmenu_app_item_get_name (item), 0);
+
+  int score = score_field (query, query_len, hyprmenu_app_item_get_generic_name_key (item),
+                           hyprmenu_app_item_get_generic_name (item), PENALTY_GENERIC_NAME);
+  best = MAX (best, score);
+
+  score = score_field (query, query_len, hyprmenu_app_item_get_keywords_key (item),
+                       NULL, PENALTY_KEYWORDS);
+  best = MAX (best, score);
+
+  score = score_field (query, query_len, hyprmenu_app_item_get_exec_key (item),
+                       NULL, PENALTY_EXEC);
+  best = MAX (best, score);
+
+  const char *description_key = hyprmenu_app_item_get_description_key (item);
+  if (best == HYPRMENU_SEARCH_NO_MATCH && description_key &&
+      find_substring (description_key, strlen (description_key), query, query_len)) {
+    best = SCORE_DESCRIPTION;
+  }
+  return best;
+}
+
+int
+hyprmenu_search_frecency_boost (double launch_score)
+{
+  if (launch_score <= 0) {
+    return 0;
+  }
+  return MIN ((int)(BONUS_FRECENCY * log2 (1.0 + launch_score)), BONUS_FRECENCY_MAX);
+}
+
+/* Best score first; equal scores in name order */
+static int
+compare_results (gconstpointer a, gconstpointer b)
+{
+  const HyprMenuSearchResult *ra = a;
+  const HyprMenuSearchResult *rb = b;
+
+  if (ra->score != rb->score) {
+    return ra->score < rb->score ? 1 : -1;
+  }
+  return strcmp (hyprmenu_app_item_get_name_key (ra->item),
+                 hyprmenu_app_item_get_name_key (rb->item));
+}
+
+static void
+rank_range (GPtrArray *items, guint first, guint last,
+            const char *query, gsize query_len, guint64 query_mask,
+            GArray *results)
+{
+  for (guint i = first; i < last; i++) {
+    HyprMenuAppItem *item = g_ptr_array_index (items, i);
+
+    /* Missing any query character rules the app out without reading its keys */
+    if (query_mask & ~hyprmenu_app_item_get_search_mask (item)) {
+      continue;
+    }
+
+    int score = hyprmenu_search_score_item (item, query, query_len);
+
+    if (score != HYPRMENU_SEARCH_NO_MATCH) {
+      HyprMenuSearchResult result = { item, score + hyprmenu_app_item_get_search_boost (item) };
+      g_array_append_val (results, result);
+    }
+  }
+}
+
+static GArray *
+results_new (guint reserved)
+{
+  return g_array_sized_new (FALSE, FALSE, sizeof (HyprMenuSearchResult), MAX (reserved, 1));
+}
+
+GArray *
+hyprmenu_search_rank (GPtrArray *items, const char *query)
+{
+  g_return_val_if_fail (items != NULL, NULL);
+  g_return_val_if_fail (query != NULL && *query, NULL);
+
+  GArray *results = results_new (items->len);
+  rank_range (items, 0, items->len, query, strlen (query),
+              hyprmenu_search_mask (query), results);
+  return results;
+}
+
+static void
+heap_sift_down (HyprMenuSearchResult *heap, guint n, guint i)
+{
+  for (;;) {
+    guint worst = i;
+    guint left = 2 * i + 1;
+    guint right = left + 1;
+
+    /* The root is the worst result kept */
+    if (left < n && compare_results (&heap[left], &heap[worst]) > 0) {
+      worst = left;
+    }
+    if (right < n && compare_results (&heap[right], &heap[worst]) > 0) {
+      worst = right;
+    }
+    if (worst == i) {
+      return;
+    }
+
+    HyprMenuSearchResult tmp = heap[i];
+    heap[i] = heap[worst];
+    heap[worst] = tmp;
+    i = worst;
+  }
+}
+
+GArray *
+hyprmenu_search_top (GArray *results, guint limit)
+{
+  g_return_val_if_fail (results != NULL, NULL);
+
+  guint n = MIN (results->len, limit);
+  GArray *top = results_new (n);
+
+  if (n == 0) {
+    return top;
+  }
+
+  /* Keep the best n in a heap rooted at the worst of them, so each other
+   * result costs one compare unless it displaces the root */
+  g_array_append_vals (top, results->data, n);
+  HyprMenuSearchResult *heap = (HyprMenuSearchResult *)top->data;
+
+  for (guint i = n / 2; i-- > 0;) {
+    heap_sift_down (heap, n, i);
+  }
+
+  for (guint i = n; i < results->len; i++) {
+    HyprMenuSearchResult *result = &g_array_index (results, HyprMenuSearchResult, i);
+    if (compare_results (result, &heap[0]) < 0) {
+      heap[0] = *result;
+      heap_sift_down (heap, n, 0);
+    }
+  }
+
+  g_array_sort (top, compare_results);
+  return top;
+}
+
+/* Items scored per unit of work; idle workers take the next chunk */
+#define RANK_CHUNK_SIZE 256
+
+typedef struct {
+  GPtrArray *items;          /* Referenced, so the caller may drop them meanwhile */
+  char *query;
+  gsize query_len;
+  guint64 query_mask;
+  guint n_chunks;
+  gint next_chunk;           /* Atomic */
+  gint workers_left;         /* Atomic; the last worker merges */
+  GArray **chunk_results;
+} RankJob;
+
+static void
+rank_job_free (gpointer data)
+{
+  RankJob *job = data;
+
+  for (guint i = 0; i < job->n_chunks; i++) {
+    if (job->chunk_results[i]) {
+      g_array_unref (job->chunk_results[i]);
+    }
+  }
+  g_free (job->chunk_results);
+  g_free (job->query);
+  g_ptr_array_unref (job->items);
+  g_free (job);
+}
+
+static void
+rank_worker (gpointer data, gpointer user_data)
+{
+  (void)user_data;
+
+  GTask *task = data;
+  RankJob *job = g_task_get_task_data (task);
+  GCancellable *cancellable = g_task_get_cancellable (task);
+
+  while (!g_cancellable_is_cancelled (cancellable)) {
+    guint chunk = g_atomic_int_add (&job->next_chunk, 1);
+    if (chunk >= job->n_chunks) {
+      break;
+    }
+
+    guint first = chunk * RANK_CHUNK_SIZE;
+    guint last = MIN (first + RANK_CHUNK_SIZE, job->items->len);
+    GArray *results = results_new (last - first);
+    rank_range (job->items, first, last, job->query, job->query_len, job->query_mask, results);
+    job->chunk_results[chunk] = results;
+  }
+
+  if (g_atomic_int_dec_and_test (&job->workers_left) &&
+      !g_task_return_error_if_cancelled (task)) {
+    guint n_results = 0;
+    for (guint i = 0; i < job->n_chunks; i++) {
+      n_results += job->chunk_results[i]->len;
+    }
+
+    GArray *merged = results_new (n_results);
+    for (guint i = 0; i < job->n_chunks; i++) {
+      g_array_append_vals (merged, job->chunk_results[i]->data, job->chunk_results[i]->len);
+    }
+
+    g_task_return_pointer (task, merged, (GDestroyNotify)g_array_unref);
+  }
+
+  g_object_unref (task);
+}
+
+static gpointer
+create_rank_pool (gpointer data)
+{
+  (void)data;
+
+  return g_thread_pool_new (rank_worker, NULL, g_get_num_processors (), FALSE, NULL);
+}
+
+void
+hyprmenu_search_rank_async (GPtrArray *items,
+                            const char *query,
+                            GCancellable *cancellable,
+                            GAsyncReadyCallback callback,
+                            gpointer user_data)
+{
+  static GOnce pool_once = G_ONCE_INIT;
+  GThreadPool *pool = g_once (&pool_once, create_rank_pool, NULL);
+
+  g_return_if_fail (items != NULL);
+  g_return_if_fail (query != NULL && *query);
+
+  RankJob *job = g_new0 (RankJob, 1);
+  job->items = g_ptr_array_new_full (items->len, g_object_unref);
+  for (guint i = 0; i < items->len; i++) {
+    g_ptr_array_add (job->items, g_object_ref (g_ptr_array_index (items, i)));
+  }
+  job->query = g_strdup (query);
+  job->query_len = strlen (query);
+  job->query_mask = hyprmenu_search_mask (query);
+  job->n_chunks = MAX ((items->len + RANK_CHUNK_SIZE - 1) / RANK_CHUNK_SIZE, 1);
+  job->chunk_results = g_new0 (GArray *, job->n_chunks);
+
+  guint n_workers = MIN (job->n_chunks, g_get_num_processors ());
+  job->workers_left = n_workers;
+
+  GTask *task = g_task_new (NULL, cancellable, callback, user_data);
+  g_task_set_source_tag (task, hyprmenu_search_rank_async);
+  g_task_set_task_data (task, job, rank_job_free);
+
+  /* Each worker holds a task reference until it has run out of chunks */
+  for (guint i = 0; i < n_workers; i++) {
+    g_thread_pool_push (pool, g_object_ref (task), NULL);
+  }
+  g_object_unref (task);
+}
+
+GArray *
+hyprmenu_search_rank_finish (GAsyncResult *result, GError **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, NULL), NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <gio/gio.h>
+#include "app_item.h"
+
+G_BEGIN_DECLS
+
+/* Longest query and text the fuzzy matcher scores; longer queries fall
+ * back to substring matching and longer texts are cut off */
+#define HYPRMENU_SEARCH_MAX_QUERY 32
+#define HYPRMENU_SEARCH_MAX_TEXT 256
+
+/* Score of an item that does not match */
+#define HYPRMENU_SEARCH_NO_MATCH G_MININT
+
+/**
+ * Result of matching a query against one text
+ */
+typedef struct {
+  int score;                                          /* Higher is better */
+  guint n_positions;                                  /* 0 for substring fallback matches */
+  guint16 positions[HYPRMENU_SEARCH_MAX_QUERY];       /* Byte offsets of matched characters, ascending */
+} HyprMenuSearchMatch;
+
+/**
+ * A ranked app
+ */
+typedef struct {
+  HyprMenuAppItem *item;                              /* Borrowed from the ranked items */
+  int score;
+} HyprMenuSearchResult;
+
+/* Below this many items ranking is quicker on the calling thread than
+ * handing it to the worker pool */
+#define HYPRMENU_SEARCH_PARALLEL_MIN 1024
+
+/**
+ * Fold text for matching: NFKD-normalize, drop combining marks so that
+ * "é" matches "e", and case-fold. Item keys are folded once when the
+ * item is created and queries once per keystroke, so matching itself
+ * is a plain byte comparison.
+ * @param text UTF-8 text, may be NULL
+ * @return A newly allocated folded string, "" for NULL or invalid UTF-8
+ */
+char* hyprmenu_search_fold(const char* text);
+
+/**
+ * Map the bytes of a folded text to a 64-bit presence mask: one bit per
+ * letter and digit, the remaining bits shared by all other bytes. A
+ * text can only match a query whose mask it covers.
+ * @param text Folded text, may be NULL
+ * @return The mask, 0 for NULL or empty text
+ */
+guint64 hyprmenu_search_mask(const char* text);
+
+/**
+ * Fuzzy-match a folded query against a folded text, fzf style: every
+ * query character must appear in order, and the alignment with the best
+ * score is chosen. Matches at word starts, camelCase humps and the very
+ * start of the text score higher, gaps between matched characters cost.
+ * @param query Folded query
+ * @param query_len Length of query in bytes, greater than 0
+ * @param text Folded text
+ * @param original The text before folding, used to find camelCase humps;
+ *                 ignored unless it has the same length as text. May be NULL.
+ * @param match Return location for the score and positions
+ * @return TRUE if the text matches
+ */
+gboolean hyprmenu_search_match(const char* query, gsize query_len,
+                               const char* text, const char* original,
+                               HyprMenuSearchMatch* match);
+
+/**
+ * Byte search kernels behind hyprmenu_search_match()'s prefilter
+ */
+typedef enum {
+  HYPRMENU_SEARCH_KERNEL_SCALAR,
+  HYPRMENU_SEARCH_KERNEL_SSE2,
+  HYPRMENU_SEARCH_KERNEL_AVX2,
+} HyprMenuSearchKernel;
+
+/**
+ * Get the prefilter kernel in use: the best one the CPU supports,
+ * unless hyprmenu_search_set_kernel() picked another
+ * @return The kernel
+ */
+HyprMenuSearchKernel hyprmenu_search_get_kernel(void);
+
+/**
+ * Override the prefilter kernel, to compare them in benchmarks. Not
+ * safe to call while a ranking is running.
+ * @param kernel The kernel to use
+ * @return FALSE if this build or CPU cannot run it
+ */
+gboolean hyprmenu_search_set_kernel(HyprMenuSearchKernel kernel);
+
+/**
+ * Score an app against a folded query over its name, generic name,
+ * keywords and Exec basename. Matches in the name rank highest. Apps
+ * none of these match still match when their description contains the
+ * query, with a score below nearly any other match.
+ * @param item The app
+ * @param query Folded query
+ * @param query_len Length of query in bytes, greater than 0
+ * @return The best score, or HYPRMENU_SEARCH_NO_MATCH
+ */
+int hyprmenu_search_score_item(HyprMenuAppItem* item, const char* query, gsize query_len);
+
+/**
+ * Turn a launch history score into a ranking bonus
+ * @param launch_score Score from hyprmenu_launch_history_get_score()
+ * @return Points to add to the app's match score
+ */
+int hyprmenu_search_frecency_boost(double launch_score);
+
+/**
+ * Score apps against a folded query, adding each app's search boost
+ * @param items HyprMenuAppItem to rank
+ * @param query Folded query, not empty
+ * @return GArray of HyprMenuSearchResult for every match, in item order;
+ *         pass to hyprmenu_search_top() for the best ones
+ */
+GArray* hyprmenu_search_rank(GPtrArray* items, const char* query);
+
+/**
+ * Rank apps on a worker pool. The items are split into chunks that
+ * workers take in turn until none are left, so all cores stay busy
+ * however uneven the chunks are. Cancelling stops the workers after
+ * their current chunk.
+ * @param items HyprMenuAppItem to rank; the job keeps its own references
+ * @param query Folded query, not empty
+ * @param cancellable Optional GCancellable; a cancelled ranking reports G_IO_ERROR_CANCELLED
+ * @param callback Called on the calling thread's main context with the result
+ * @param user_data Data for the callback
+ */
+void hyprmenu_search_rank_async(GPtrArray* items,
+                                const char* query,
+                                GCancellable* cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data);
+
+/**
+ * Finish hyprmenu_search_rank_async()
+ * @return GArray of HyprMenuSearchResult as for hyprmenu_search_rank(),
+ *         or NULL with @error set. Items are borrowed from the ranked
+ *         items, so they are only valid while the caller still holds them.
+ */
+GArray* hyprmenu_search_rank_finish(GAsyncResult* result, GError** error);
+
+/**
+ * Select the best results without sorting the rest: a heap of the
+ * limit best, then a sort of just those
+ * @param results GArray of HyprMenuSearchResult
+ * @param limit Maximum number of results to select
+ * @return A new GArray of at most limit results, best first; equal
+ *         scores are in name order
+ */
+GArray* hyprmenu_search_top(GArray* results, guint limit);
+
+G_END_DECLS
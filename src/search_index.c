@@ -0,0 +1,193 @@
+#include "search_index.h"
+#include "search.h"
+#include <string.h>
+
+struct _HyprMenuSearchIndex
+{
+  GPtrArray *items;          /* HyprMenuAppItem; an app's ID is its index here */
+  GArray *bytes[256];        /* App IDs whose keys contain each byte, ascending */
+  GHashTable *trigrams;      /* Packed trigram -> GArray of app IDs, ascending */
+};
+
+static inline guint32
+pack_trigram (const char *p)
+{
+  return ((guint32)(guchar)p[0] << 16) | ((guint32)(guchar)p[1] << 8) | (guchar)p[2];
+}
+
+static GArray *
+postings_new (void)
+{
+  return g_array_new (FALSE, FALSE, sizeof (guint32));
+}
+
+static void
+postings_add (GArray *postings, guint32 id)
+{
+  /* Apps are indexed in ID order, so a repeat is always the last entry */
+  if (postings->len > 0 && g_array_index (postings, guint32, postings->len - 1) == id) {
+    return;
+  }
+  g_array_append_val (postings, id);
+}
+
+static void
+index_key (HyprMenuSearchIndex *self, guint32 id, const char *key)
+{
+  if (!key) {
+    return;
+  }
+
+  gsize len = strlen (key);
+
+  for (gsize i = 0; i < len; i++) {
+    guchar c = key[i];
+    if (!self->bytes[c]) {
+      self->bytes[c] = postings_new ();
+    }
+    postings_add (self->bytes[c], id);
+  }
+
+  for (gsize i = 0; i + 3 <= len; i++) {
+    gpointer trigram = GUINT_TO_POINTER (pack_trigram (key + i));
+    GArray *postings = g_hash_table_lookup (self->trigrams, trigram);
+    if (!postings) {
+      postings = postings_new ();
+      g_hash_table_insert (self->trigrams, trigram, postings);
+    }
+    postings_add (postings, id);
+  }
+}
+
+HyprMenuSearchIndex *
+hyprmenu_search_index_new (GListModel *apps)
+{
+  HyprMenuSearchIndex *self = g_new0 (HyprMenuSearchIndex, 1);
+  guint n_apps = g_list_model_get_n_items (apps);
+
+  self->items = g_ptr_array_new_full (n_apps, g_object_unref);
+  self->trigrams = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+                                          NULL, (GDestroyNotify)g_array_unref);
+
+  for (guint i = 0; i < n_apps; i++) {
+    HyprMenuAppItem *item = g_list_model_get_item (apps, i);
+    g_ptr_array_add (self->items, item);
+
+    index_key (self, i, hyprmenu_app_item_get_name_key (item));
+    index_key (self, i, hyprmenu_app_item_get_generic_name_key (item));
+    index_key (self, i, hyprmenu_app_item_get_keywords_key (item));
+    index_key (self, i, hyprmenu_app_item_get_exec_key (item));
+    index_key (self, i, hyprmenu_app_item_get_description_key (item));
+  }
+
+  return self;
+}
+
+void
+hyprmenu_search_index_free (HyprMenuSearchIndex *self)
+{
+  if (!self) {
+    return;
+  }
+
+  for (guint i = 0; i < G_N_ELEMENTS (self->bytes); i++) {
+    if (self->bytes[i]) {
+      g_array_unref (self->bytes[i]);
+    }
+  }
+  g_hash_table_unref (self->trigrams);
+  g_ptr_array_unref (self->items);
+  g_free (self);
+}
+
+static int
+compare_postings_length (gconstpointer a, gconstpointer b)
+{
+  const GArray *pa = *(GArray * const *)a;
+  const GArray *pb = *(GArray * const *)b;
+
+  return (pa->len > pb->len) - (pa->len < pb->len);
+}
+
+/* Keep the IDs of ids that are also in postings; both ascending */
+static void
+intersect (GArray *ids, const GArray *postings)
+{
+  guint kept = 0;
+  guint j = 0;
+
+  for (guint i = 0; i < ids->len && j < postings->len; i++) {
+    guint32 id = g_array_index (ids, guint32, i);
+
+    while (j < postings->len && g_array_index (postings, guint32, j) < id) {
+      j++;
+    }
+    if (j < postings->len && g_array_index (postings, guint32, j) == id) {
+      g_array_index (ids, guint32, kept++) = id;
+    }
+  }
+
+  g_array_set_size (ids, kept);
+}
+
+GPtrArray *
+hyprmenu_search_index_candidates (HyprMenuSearchIndex *self,
+                                  const char *query,
+                                  gsize query_len)
+{
+  g_return_val_if_fail (self != NULL, NULL);
+  g_return_val_if_fail (query != NULL && query_len > 0, NULL);
+
+  GPtrArray *candidates = g_ptr_array_new ();
+  GPtrArray *lists = g_ptr_array_new ();
+  gboolean missing = FALSE;
+
+  if (query_len > HYPRMENU_SEARCH_MAX_QUERY) {
+    for (gsize i = 0; i + 3 <= query_len && !missing; i++) {
+      GArray *postings = g_hash_table_lookup (self->trigrams,
+                                              GUINT_TO_POINTER (pack_trigram (query + i)));
+      if (postings) {
+        g_ptr_array_add (lists, postings);
+      } else {
+        missing = TRUE;
+      }
+    }
+  } else {
+    gboolean seen[256] = { FALSE };
+
+    for (gsize i = 0; i < query_len && !missing; i++) {
+      guchar c = query[i];
+      if (seen[c]) {
+        continue;
+      }
+      seen[c] = TRUE;
+
+      if (self->bytes[c]) {
+        g_ptr_array_add (lists, self->bytes[c]);
+      } else {
+        missing = TRUE;
+      }
+    }
+  }
+
+  if (!missing && lists->len > 0) {
+    /* Start from the rarest posting list so the working set stays small */
+    g_ptr_array_sort (lists, compare_postings_length);
+
+    const GArray *rarest = g_ptr_array_index (lists, 0);
+    GArray *ids = g_array_sized_new (FALSE, FALSE, sizeof (guint32), rarest->len);
+    g_array_append_vals (ids, rarest->data, rarest->len);
+
+    for (guint i = 1; i < lists->len && ids->len > 0; i++) {
+      intersect (ids, g_ptr_array_index (lists, i));
+    }
+
+    for (guint i = 0; i < ids->len; i++) {
+      g_ptr_array_add (candidates, g_ptr_array_index (self->items, g_array_index (ids, guint32, i)));
+    }
+    g_array_unref (ids);
+  }
+
+  g_ptr_array_unref (lists);
+  return candidates;
+}
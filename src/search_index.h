@@ -0,0 +1,42 @@
+#pragma once
+
+#include <gio/gio.h>
+#include "app_item.h"
+
+G_BEGIN_DECLS
+
+typedef struct _HyprMenuSearchIndex HyprMenuSearchIndex;
+
+/**
+ * Build an inverted index over the folded search keys of every app in
+ * a model: name, generic name, keywords, Exec basename and description.
+ * Every byte maps to the apps whose keys contain it, and every trigram
+ * to the apps with a key containing it.
+ * @param apps A model of HyprMenuAppItem; the index keeps its own
+ *             references and does not follow later changes
+ * @return A new index, free with hyprmenu_search_index_free()
+ */
+HyprMenuSearchIndex* hyprmenu_search_index_new(GListModel* apps);
+
+/**
+ * Free an index
+ * @param self The index
+ */
+void hyprmenu_search_index_free(HyprMenuSearchIndex* self);
+
+/**
+ * Get the apps that can match a folded query. Fuzzy queries need every
+ * query byte somewhere in the keys; queries too long for the fuzzy
+ * matcher are matched as substrings and need every query trigram. The
+ * result is a superset of the matches, in index order.
+ * @param self The index
+ * @param query Folded query
+ * @param query_len Length of query in bytes, greater than 0
+ * @return Array of HyprMenuAppItem owned by the index, free the array
+ *         with g_ptr_array_unref()
+ */
+GPtrArray* hyprmenu_search_index_candidates(HyprMenuSearchIndex* self,
+                                            const char* query,
+                                            gsize query_len);
+
+G_END_DECLS
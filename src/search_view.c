@@ -0,0 +1,274 @@
+#include "search_view.h"
+#include "search.h"
+#include "config.h"
+#include <string.h>
+
+struct _HyprMenuSearchView
+{
+  GtkWidget parent_instance;
+
+  GtkWidget *scrolled_window;
+  GtkWidget *list_view;
+
+  GListStore *results;         // HyprMenuAppItem in rank order
+  char *query;                 // Folded query the results were ranked for
+};
+
+typedef struct {
+  GtkWidget *icon;
+  GtkWidget *name_label;
+  GtkWidget *desc_label;
+} ResultRow;
+
+G_DEFINE_TYPE (HyprMenuSearchView, hyprmenu_search_view, GTK_TYPE_WIDGET)
+
+static void
+launch_item (HyprMenuSearchView *self, HyprMenuAppItem *item)
+{
+  GError *error = NULL;
+
+  if (!hyprmenu_app_item_launch (item, &error)) {
+    g_warning ("Failed to launch application: %s", error->message);
+    g_error_free (error);
+    return;
+  }
+
+  // Close the menu window if configured to do so
+  if (config->close_on_app_launch) {
+    GtkRoot *root = gtk_widget_get_root (GTK_WIDGET (self));
+    if (GTK_IS_WINDOW (root)) {
+      gtk_window_close (GTK_WINDOW (root));
+    }
+  }
+}
+
+static void
+on_result_activated (GtkListView *list_view,
+                     guint position,
+                     gpointer user_data)
+{
+  (void)list_view;
+
+  HyprMenuSearchView *self = HYPRMENU_SEARCH_VIEW (user_data);
+  HyprMenuAppItem *item = g_list_model_get_item (G_LIST_MODEL (self->results), position);
+
+  if (item) {
+    launch_item (self, item);
+    g_object_unref (item);
+  }
+}
+
+/* Mark the characters of the name the query matched. Match positions
+ * are offsets into the folded key, so this only highlights names that
+ * folding did not change in length, which covers ASCII names. */
+static char *
+highlight_name (HyprMenuAppItem *item, const char *query)
+{
+  const char *name = hyprmenu_app_item_get_name (item);
+  const char *key = hyprmenu_app_item_get_name_key (item);
+  gsize query_len = query ? strlen (query) : 0;
+  HyprMenuSearchMatch match;
+
+  if (query_len == 0 || strlen (name) != strlen (key) ||
+      !hyprmenu_search_match (query, query_len, key, name, &match) ||
+      match.n_positions == 0) {
+    return g_markup_escape_text (name, -1);
+  }
+
+  GString *markup = g_string_new (NULL);
+  guint next = 0;
+
+  for (const char *p = name; *p; p = g_utf8_next_char (p)) {
+    gsize offset = p - name;
+    gsize len = g_utf8_next_char (p) - p;
+    gboolean matched = FALSE;
+
+    while (next < match.n_positions && match.positions[next] < offset + len) {
+      matched = TRUE;
+      next++;
+    }
+
+    char *escaped = g_markup_escape_text (p, len);
+    if (matched) {
+      g_string_append_printf (markup, "<b>%s</b>", escaped);
+    } else {
+      g_string_append (markup, escaped);
+    }
+    g_free (escaped);
+  }
+
+  return g_string_free (markup, FALSE);
+}
+
+static void
+on_row_setup (GtkSignalListItemFactory *factory,
+              GtkListItem *list_item,
+              gpointer user_data)
+{
+  (void)factory;
+  (void)user_data;
+
+  ResultRow *row = g_new0 (ResultRow, 1);
+
+  GtkWidget *box = gtk_box_new (GTK_ORIENTATION_HORIZONTAL, 8);
+  gtk_widget_add_css_class (box, "hyprmenu-app-entry");
+  gtk_widget_set_margin_start (box, 4);
+  gtk_widget_set_margin_end (box, 4);
+  gtk_widget_set_margin_top (box, 2);
+  gtk_widget_set_margin_bottom (box, 2);
+  gtk_widget_set_size_request (box, -1, config->list_item_size);
+
+  row->icon = gtk_image_new ();
+  gtk_image_set_pixel_size (GTK_IMAGE (row->icon), config->list_item_size * 0.75);
+  gtk_widget_set_margin_start (row->icon, config->app_entry_padding);
+  gtk_widget_add_css_class (row->icon, "hyprmenu-app-icon");
+  gtk_box_append (GTK_BOX (box), row->icon);
+
+  GtkWidget *label_box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 2);
+  gtk_widget_set_hexpand (label_box, TRUE);
+  gtk_widget_set_valign (label_box, GTK_ALIGN_CENTER);
+  gtk_widget_set_margin_start (label_box, config->app_entry_padding);
+  gtk_widget_set_margin_end (label_box, config->app_entry_padding);
+  gtk_box_append (GTK_BOX (box), label_box);
+
+  row->name_label = gtk_label_new (NULL);
+  gtk_label_set_xalign (GTK_LABEL (row->name_label), 0);
+  gtk_label_set_ellipsize (GTK_LABEL (row->name_label), PANGO_ELLIPSIZE_END);
+  gtk_widget_add_css_class (row->name_label, "app-name");
+  gtk_box_append (GTK_BOX (label_box), row->name_label);
+
+  row->desc_label = gtk_label_new (NULL);
+  gtk_label_set_xalign (GTK_LABEL (row->desc_label), 0);
+  gtk_label_set_ellipsize (GTK_LABEL (row->desc_label), PANGO_ELLIPSIZE_END);
+  gtk_widget_add_css_class (row->desc_label, "app-description");
+  gtk_box_append (GTK_BOX (label_box), row->desc_label);
+
+  gtk_list_item_set_child (list_item, box);
+  g_object_set_data_full (G_OBJECT (list_item), "result-row", row, g_free);
+}
+
+static void
+on_row_bind (GtkSignalListItemFactory *factory,
+             GtkListItem *list_item,
+             gpointer user_data)
+{
+  (void)factory;
+
+  HyprMenuSearchView *self = HYPRMENU_SEARCH_VIEW (user_data);
+  HyprMenuAppItem *item = gtk_list_item_get_item (list_item);
+  ResultRow *row = g_object_get_data (G_OBJECT (list_item), "result-row");
+
+  GIcon *icon = hyprmenu_app_item_get_icon (item);
+  if (icon) {
+    gtk_image_set_from_gicon (GTK_IMAGE (row->icon), icon);
+  } else {
+    gtk_image_set_from_icon_name (GTK_IMAGE (row->icon), "application-x-executable");
+  }
+
+  char *name = highlight_name (item, self->query);
+  char *markup = g_strdup_printf ("<span size='%d'>%s</span>",
+                                  config->app_name_font_size * PANGO_SCALE, name);
+  gtk_label_set_markup (GTK_LABEL (row->name_label), markup);
+  g_free (markup);
+  g_free (name);
+
+  const char *description = hyprmenu_app_item_get_description (item);
+  if (!description) {
+    description = hyprmenu_app_item_get_generic_name (item);
+  }
+  gtk_label_set_text (GTK_LABEL (row->desc_label), description ? description : "");
+  gtk_widget_set_visible (row->desc_label, description != NULL);
+}
+
+static void
+hyprmenu_search_view_dispose (GObject *object)
+{
+  HyprMenuSearchView *self = HYPRMENU_SEARCH_VIEW (object);
+
+  if (self->scrolled_window) {
+    gtk_widget_unparent (self->scrolled_window);
+    self->scrolled_window = NULL;
+    self->list_view = NULL;
+  }
+
+  g_clear_object (&self->results);
+  g_clear_pointer (&self->query, g_free);
+
+  G_OBJECT_CLASS (hyprmenu_search_view_parent_class)->dispose (object);
+}
+
+static void
+hyprmenu_search_view_class_init (HyprMenuSearchViewClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
+
+  object_class->dispose = hyprmenu_search_view_dispose;
+
+  gtk_widget_class_set_layout_manager_type (widget_class, GTK_TYPE_BIN_LAYOUT);
+}
+
+static void
+hyprmenu_search_view_init (HyprMenuSearchView *self)
+{
+  self->results = g_list_store_new (HYPRMENU_TYPE_APP_ITEM);
+  self->query = NULL;
+
+  GtkListItemFactory *factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect (factory, "setup", G_CALLBACK (on_row_setup), self);
+  g_signal_connect (factory, "bind", G_CALLBACK (on_row_bind), self);
+
+  GtkNoSelection *selection = gtk_no_selection_new (G_LIST_MODEL (g_object_ref (self->results)));
+  self->list_view = gtk_list_view_new (GTK_SELECTION_MODEL (selection), factory);
+  gtk_list_view_set_single_click_activate (GTK_LIST_VIEW (self->list_view), TRUE);
+  gtk_widget_add_css_class (self->list_view, "hyprmenu-search-results");
+  g_signal_connect (self->list_view, "activate", G_CALLBACK (on_result_activated), self);
+
+  self->scrolled_window = gtk_scrolled_window_new ();
+  gtk_scrolled_window_set_policy (GTK_SCROLLED_WINDOW (self->scrolled_window),
+                                  GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_scrolled_window_set_child (GTK_SCROLLED_WINDOW (self->scrolled_window), self->list_view);
+  gtk_widget_set_parent (self->scrolled_window, GTK_WIDGET (self));
+  gtk_widget_set_vexpand (GTK_WIDGET (self), TRUE);
+}
+
+GtkWidget *
+hyprmenu_search_view_new (void)
+{
+  return g_object_new (HYPRMENU_TYPE_SEARCH_VIEW, NULL);
+}
+
+void
+hyprmenu_search_view_set_results (HyprMenuSearchView *self,
+                                  const char *query,
+                                  HyprMenuAppItem **items,
+                                  guint n_items)
+{
+  g_return_if_fail (HYPRMENU_IS_SEARCH_VIEW (self));
+
+  g_free (self->query);
+  self->query = g_strdup (query);
+
+  /* One items-changed for the whole list; only rows on screen rebind */
+  g_list_store_splice (self->results, 0, g_list_model_get_n_items (G_LIST_MODEL (self->results)),
+                       (gpointer *)items, n_items);
+
+  if (n_items > 0) {
+    gtk_list_view_scroll_to (GTK_LIST_VIEW (self->list_view), 0, GTK_LIST_SCROLL_NONE, NULL);
+  }
+}
+
+gboolean
+hyprmenu_search_view_launch_first (HyprMenuSearchView *self)
+{
+  g_return_val_if_fail (HYPRMENU_IS_SEARCH_VIEW (self), FALSE);
+
+  HyprMenuAppItem *item = g_list_model_get_item (G_LIST_MODEL (self->results), 0);
+  if (!item) {
+    return FALSE;
+  }
+
+  launch_item (self, item);
+  g_object_unref (item);
+  return TRUE;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <gtk/gtk.h>
+#include "app_item.h"
+
+G_BEGIN_DECLS
+
+#define HYPRMENU_TYPE_SEARCH_VIEW (hyprmenu_search_view_get_type())
+G_DECLARE_FINAL_TYPE (HyprMenuSearchView, hyprmenu_search_view, HYPRMENU, SEARCH_VIEW, GtkWidget)
+
+/**
+ * Create the ranked result list shown in place of the category views
+ * while a search is active
+ */
+GtkWidget* hyprmenu_search_view_new (void);
+
+/**
+ * Replace the results
+ * @param self The search view
+ * @param query The folded query the results were ranked for, used to
+ *              highlight the matched characters
+ * @param items Items in rank order, best first
+ * @param n_items Number of items
+ */
+void hyprmenu_search_view_set_results (HyprMenuSearchView *self,
+                                       const char *query,
+                                       HyprMenuAppItem **items,
+                                       guint n_items);
+
+/**
+ * Launch the best result
+ * @param self The search view
+ * @return TRUE if there was a result to launch
+ */
+gboolean hyprmenu_search_view_launch_first (HyprMenuSearchView *self);
+
+G_END_DECLS
@@ -5,6 +5,7 @@
 #include <gdk/gdk.h>
 #include <gdk/wayland/gdkwayland.h>
 #include "app_grid.h"
+#include "pywal.h"
 
 // Add this struct definition at the top of the file, after the includes
 typedef struct {
@@ -33,12 +34,48 @@ static void on_lock_clicked(GtkButton *button, gpointer user_data);
 
 G_DEFINE_TYPE (HyprMenuWindow, hyprmenu_window, GTK_TYPE_APPLICATION_WINDOW)
 
+/* Delay between the last change to the config file and reloading it */
+#define CONFIG_RELOAD_DELAY_MS 100
+
+/* Filter with whatever the entry holds when the frame is drawn, so
+ * bursts of changes within one frame cost a single search */
+static gboolean
+on_search_tick (GtkWidget *widget,
+                GdkFrameClock *frame_clock,
+                gpointer user_data)
+{
+  (void)frame_clock;
+  
+  HyprMenuWindow *self = HYPRMENU_WINDOW (user_data);
+  self->search_tick_id = 0;
+  
+  const char *text = gtk_editable_get_text (GTK_EDITABLE (widget));
+  
+  if (!self->app_grid) {
+    g_warning("on_search_tick: App grid is NULL");
+    return G_SOURCE_REMOVE;
+  }
+  
+  hyprmenu_app_grid_filter (HYPRMENU_APP_GRID (self->app_grid), text);
+  return G_SOURCE_REMOVE;
+}
+
+/* Run a pending search now instead of on the next frame */
+static void
+flush_search (HyprMenuWindow *self)
+{
+  if (!self->search_tick_id) {
+    return;
+  }
+  
+  gtk_widget_remove_tick_callback (self->search_entry, self->search_tick_id);
+  on_search_tick (self->search_entry, NULL, self);
+}
+
 static void
 on_search_changed (GtkSearchEntry *entry,
                   HyprMenuWindow *self)
 {
-  g_print("on_search_changed: Search text changed\n");
-  
   if (!entry) {
     g_warning("on_search_changed: Search entry is NULL");
     return;
@@ -49,25 +86,23 @@ on_search_changed (GtkSearchEntry *entry,
     return;
   }
   
-  const char *text = gtk_editable_get_text (GTK_EDITABLE (entry));
-  g_print("on_search_changed: Search text is '%s'\n", text ? text : "NULL");
-  
-  if (!self->app_grid) {
-    g_warning("on_search_changed: App grid is NULL");
-    return;
+  if (!self->search_tick_id) {
+    self->search_tick_id = gtk_widget_add_tick_callback (GTK_WIDGET (entry), on_search_tick,
+                                                         self, NULL);
   }
-  
-  hyprmenu_app_grid_filter (HYPRMENU_APP_GRID (self->app_grid), text);
-  g_print("on_search_changed: Filter applied successfully\n");
 }
 
 static void
 on_search_activate (GtkSearchEntry *entry,
                    HyprMenuWindow *self)
 {
-  // Handle search activation if needed
   (void)entry;
-  (void)self;
+  
+  // Enter launches the best match for everything typed so far
+  flush_search (self);
+  if (self->app_grid) {
+    hyprmenu_app_grid_launch_first_result (HYPRMENU_APP_GRID (self->app_grid));
+  }
 }
 
 static void
@@ -88,12 +123,21 @@ on_focus_out (GtkWindow *window,
   (void)user_data;
   
   // Close the window when it loses focus
-  if (config->close_on_focus_out) {
-    GtkApplication *app = GTK_APPLICATION(gtk_window_get_application(window));
-    gtk_window_close(window);
-    if (app) {
-      g_application_quit(G_APPLICATION(app));
-    }
+  if (config->close_on_focus_out && gtk_widget_get_visible(GTK_WIDGET(window))) {
+    hyprmenu_window_dismiss(HYPRMENU_WINDOW(window));
+  }
+}
+
+static void
+on_hide (GtkWidget *widget,
+         gpointer   user_data)
+{
+  (void)user_data;
+  
+  // Start from an empty query the next time a resident menu is shown
+  HyprMenuWindow *self = HYPRMENU_WINDOW(widget);
+  if (self->search_entry) {
+    gtk_editable_set_text(GTK_EDITABLE(self->search_entry), "");
   }
 }
 
@@ -111,11 +155,7 @@ on_key_press (GtkEventControllerKey *controller,
   // Close window on Escape key press
   if (keyval == GDK_KEY_Escape) {
     if (config->close_on_escape) {
-    GtkApplication *app = GTK_APPLICATION(gtk_window_get_application(GTK_WINDOW(self)));
-    gtk_window_close(GTK_WINDOW(self));
-    if (app) {
-      g_application_quit(G_APPLICATION(app));
-    }
+    hyprmenu_window_dismiss(self);
     return TRUE;
     }
   }
@@ -123,11 +163,7 @@ on_key_press (GtkEventControllerKey *controller,
   // Close window on Super key press if configured
   if ((keyval == GDK_KEY_Super_L || keyval == GDK_KEY_Super_R) && 
       config->close_on_super_key) {
-    GtkApplication *app = GTK_APPLICATION(gtk_window_get_application(GTK_WINDOW(self)));
-    gtk_window_close(GTK_WINDOW(self));
-    if (app) {
-      g_application_quit(G_APPLICATION(app));
-    }
+    hyprmenu_window_dismiss(self);
     return TRUE;
   }
   
@@ -205,11 +241,7 @@ on_click_outside(GtkGestureClick *gesture,
       transformed.x > bounds.origin.x + bounds.size.width || 
       transformed.y > bounds.origin.y + bounds.size.height) {
     g_print("Click outside main box - closing window\n");
-    GtkApplication *app = gtk_window_get_application(GTK_WINDOW(self));
-    gtk_window_close(GTK_WINDOW(self));
-    if (app) {
-      g_application_quit(G_APPLICATION(app));
-    }
+    hyprmenu_window_dismiss(self);
   }
 }
 
@@ -495,68 +527,10 @@ create_system_button (const char *icon_name, const char *label, GCallback callba
   return button;
 }
 
+/* Anchor the layer surface and set its margins from menu_position */
 static void
-hyprmenu_window_init (HyprMenuWindow *self)
+apply_layer_position (HyprMenuWindow *self)
 {
-  /* Set window properties */
-  gtk_window_set_default_size(GTK_WINDOW(self), config->window_width, config->window_height);
-  gtk_window_set_resizable(GTK_WINDOW(self), FALSE);
-  gtk_window_set_decorated(GTK_WINDOW(self), FALSE);
-  
-  /* Initialize layer shell */
-  GdkDisplay *display = gtk_widget_get_display(GTK_WIDGET(self));
-  if (!GDK_IS_WAYLAND_DISPLAY(display)) {
-    g_error("HyprMenu requires Wayland");
-    return;
-  }
-
-  if (!gtk_layer_is_supported()) {
-    g_error("GTK Layer Shell is required but not supported");
-    return;
-  }
-  
-  g_message("Initializing GTK Layer Shell for window");
-  gtk_layer_init_for_window(GTK_WINDOW(self));
-  
-  g_message("Setting layer shell properties");
-  gtk_layer_set_layer(GTK_WINDOW(self), GTK_LAYER_SHELL_LAYER_OVERLAY);
-  gtk_layer_set_keyboard_mode(GTK_WINDOW(self), GTK_LAYER_SHELL_KEYBOARD_MODE_EXCLUSIVE);
-  gtk_layer_set_exclusive_zone(GTK_WINDOW(self), -1);
-  
-  /* Set namespace for blur and other effects */
-  gtk_layer_set_namespace(GTK_WINDOW(self), "hyprmenu");
-  
-  /* Enable blur for Hyprland */
-  GdkSurface *surface = gtk_native_get_surface(GTK_NATIVE(self));
-  if (GDK_IS_WAYLAND_SURFACE(surface)) {
-    // Set window background to transparent to allow blur
-    GtkStyleContext *style_context = gtk_widget_get_style_context(GTK_WIDGET(self));
-    GtkCssProvider *provider = gtk_css_provider_new();
-    gtk_css_provider_load_from_data(provider, 
-                                   ".hyprmenu-window { "
-                                   "  background-color: rgba(0, 0, 0, 0.0); "
-                                   "  border-radius: 16px; "
-                                   "  overflow: hidden; "
-                                   "}\n"
-                                   ".hyprmenu-main-box { "
-                                   "  border-radius: 12px; "
-                                   "  overflow: hidden; "
-                                   "}\n"
-                                   "window, .background { "
-                                   "  border-radius: 16px; "
-                                   "  overflow: hidden; "
-                                   "}"
-                                   ,
-                                   -1);
-    gtk_style_context_add_provider(style_context,
-                                  GTK_STYLE_PROVIDER(provider),
-                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
-    g_object_unref(provider);
-    
-    g_message("Enabled native Hyprland blur support with improved corner radius");
-  }
-  
-  /* Position window based on menu_position config */
   g_message("Setting window position to: %d", config->menu_position);
   
   int bottom_margin = (config->bottom_offset == 0) ? 2 : (config->bottom_offset + 2);
@@ -632,6 +606,140 @@ hyprmenu_window_init (HyprMenuWindow *self)
       gtk_layer_set_margin(GTK_WINDOW(self), GTK_LAYER_SHELL_EDGE_LEFT, config->left_margin);
       break;
   }
+}
+
+/* Apply config changes made on disk to the running menu, touching only
+ * what the changed sections configure */
+static void
+apply_config_changes (HyprMenuWindow *self, HyprMenuConfigSection changed)
+{
+  if (changed & HYPRMENU_CONFIG_STYLE_SECTIONS) {
+    hyprmenu_config_apply_css();
+  }
+  
+  if (changed & HYPRMENU_CONFIG_LAYOUT) {
+    gtk_window_set_default_size(GTK_WINDOW(self), config->window_width, config->window_height);
+    apply_layer_position(self);
+  }
+  
+  if (changed & HYPRMENU_CONFIG_SEARCH) {
+    gtk_widget_set_size_request(self->search_entry,
+                                config->search_length > 0 ? config->search_length : -1, -1);
+  }
+  
+  hyprmenu_app_grid_apply_config(HYPRMENU_APP_GRID(self->app_grid), changed);
+}
+
+/* A reload that had to wait for a config write */
+static void
+on_config_reloaded (HyprMenuConfigSection changed, gpointer user_data)
+{
+  apply_config_changes(HYPRMENU_WINDOW(user_data), changed);
+}
+
+static gboolean
+reload_config (gpointer user_data)
+{
+  HyprMenuWindow *self = HYPRMENU_WINDOW(user_data);
+  
+  self->config_reload_id = 0;
+  
+  HyprMenuConfigSection changed = hyprmenu_config_reload();
+  if (changed) {
+    apply_config_changes(self, changed);
+  }
+  
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_config_file_changed (GFileMonitor      *monitor,
+                        GFile             *file,
+                        GFile             *other_file,
+                        GFileMonitorEvent  event_type,
+                        gpointer           user_data)
+{
+  HyprMenuWindow *self = HYPRMENU_WINDOW(user_data);
+  
+  (void)monitor;
+  (void)file;
+  (void)other_file;
+  
+  if (event_type == G_FILE_MONITOR_EVENT_DELETED ||
+      event_type == G_FILE_MONITOR_EVENT_ATTRIBUTE_CHANGED) {
+    return;
+  }
+  
+  /* Editors save in several steps; reload once they are done */
+  if (self->config_reload_id) {
+    g_source_remove(self->config_reload_id);
+  }
+  self->config_reload_id = g_timeout_add(CONFIG_RELOAD_DELAY_MS, reload_config, self);
+}
+
+static void
+hyprmenu_window_init (HyprMenuWindow *self)
+{
+  /* Set window properties */
+  gtk_window_set_default_size(GTK_WINDOW(self), config->window_width, config->window_height);
+  gtk_window_set_resizable(GTK_WINDOW(self), FALSE);
+  gtk_window_set_decorated(GTK_WINDOW(self), FALSE);
+  
+  /* Initialize layer shell */
+  GdkDisplay *display = gtk_widget_get_display(GTK_WIDGET(self));
+  if (!GDK_IS_WAYLAND_DISPLAY(display)) {
+    g_error("HyprMenu requires Wayland");
+    return;
+  }
+
+  if (!gtk_layer_is_supported()) {
+    g_error("GTK Layer Shell is required but not supported");
+    return;
+  }
+  
+  g_message("Initializing GTK Layer Shell for window");
+  gtk_layer_init_for_window(GTK_WINDOW(self));
+  
+  g_message("Setting layer shell properties");
+  gtk_layer_set_layer(GTK_WINDOW(self), GTK_LAYER_SHELL_LAYER_OVERLAY);
+  gtk_layer_set_keyboard_mode(GTK_WINDOW(self), GTK_LAYER_SHELL_KEYBOARD_MODE_EXCLUSIVE);
+  gtk_layer_set_exclusive_zone(GTK_WINDOW(self), -1);
+  
+  /* Set namespace for blur and other effects */
+  gtk_layer_set_namespace(GTK_WINDOW(self), "hyprmenu");
+  
+  /* Enable blur for Hyprland */
+  GdkSurface *surface = gtk_native_get_surface(GTK_NATIVE(self));
+  if (GDK_IS_WAYLAND_SURFACE(surface)) {
+    // Set window background to transparent to allow blur
+    GtkStyleContext *style_context = gtk_widget_get_style_context(GTK_WIDGET(self));
+    GtkCssProvider *provider = gtk_css_provider_new();
+    gtk_css_provider_load_from_data(provider, 
+                                   ".hyprmenu-window { "
+                                   "  background-color: rgba(0, 0, 0, 0.0); "
+                                   "  border-radius: 16px; "
+                                   "  overflow: hidden; "
+                                   "}\n"
+                                   ".hyprmenu-main-box { "
+                                   "  border-radius: 12px; "
+                                   "  overflow: hidden; "
+                                   "}\n"
+                                   "window, .background { "
+                                   "  border-radius: 16px; "
+                                   "  overflow: hidden; "
+                                   "}"
+                                   ,
+                                   -1);
+    gtk_style_context_add_provider(style_context,
+                                  GTK_STYLE_PROVIDER(provider),
+                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
+    g_object_unref(provider);
+    
+    g_message("Enabled native Hyprland blur support with improved corner radius");
+  }
+  
+  /* Position window based on menu_position config */
+  apply_layer_position(self);
   
   /* Add CSS classes for styling */
   gtk_widget_add_css_class (GTK_WIDGET (self), "hyprmenu-window");
@@ -664,6 +772,8 @@ hyprmenu_window_init (HyprMenuWindow *self)
   
   // Search bar
   self->search_entry = gtk_search_entry_new();
+  // Searches are coalesced per frame instead of delayed
+  gtk_search_entry_set_search_delay(GTK_SEARCH_ENTRY(self->search_entry), 0);
   gtk_widget_add_css_class(self->search_entry, "hyprmenu-search");
   gtk_widget_set_hexpand(self->search_entry, TRUE);
   gtk_widget_set_halign(self->search_entry, GTK_ALIGN_FILL);
@@ -694,23 +804,6 @@ hyprmenu_window_init (HyprMenuWindow *self)
   gtk_widget_set_vexpand(self->app_grid, TRUE);
   gtk_box_append(GTK_BOX(content_container), self->app_grid);
   
-  // Set grid columns if in grid view
-  if (config->grid_hexpand) {
-    GtkWidget *category_list = NULL;
-    GObject *grid_obj = NULL;
-    // Try to get the category list from the app_grid
-    g_object_get(self->app_grid, "category_list", &category_list, NULL);
-    if (category_list) {
-      // Set columns for the flow box
-      GtkWidget *all_apps_grid = NULL;
-      g_object_get(category_list, "all_apps_grid", &all_apps_grid, NULL);
-      if (all_apps_grid) {
-        gtk_flow_box_set_max_children_per_line(GTK_FLOW_BOX(all_apps_grid), config->grid_columns);
-        gtk_flow_box_set_min_children_per_line(GTK_FLOW_BOX(all_apps_grid), config->grid_columns);
-      }
-    }
-  }
-  
   /* Create system buttons box at the bottom */
   self->system_buttons_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 2);
   gtk_widget_add_css_class(self->system_buttons_box, "hyprmenu-system-buttons");
@@ -763,9 +856,15 @@ hyprmenu_window_init (HyprMenuWindow *self)
   /* Connect focus-out signal */
   g_signal_connect(self, "notify::has-focus", G_CALLBACK(on_focus_out), NULL);
   
+  /* Reset state when a resident menu is hidden */
+  g_signal_connect(self, "hide", G_CALLBACK(on_hide), NULL);
+  
   /* Apply custom CSS from configuration */
   hyprmenu_config_apply_css();
   
+  /* Named pywal colors the config colors may refer to */
+  hyprmenu_pywal_init();
+  
   /* Set dark color scheme */
   GtkSettings *settings = gtk_settings_get_default();
   g_object_set(settings, "gtk-application-prefer-dark-theme", TRUE, NULL);
@@ -778,6 +877,15 @@ hyprmenu_window_init (HyprMenuWindow *self)
   if (config->search_length > 0) {
     gtk_widget_set_size_request(self->search_entry, config->search_length, -1);
   }
+  
+  /* Follow edits to the config file while the menu is running */
+  GFile *config_file = g_file_new_for_path(config->config_file);
+  self->config_monitor = g_file_monitor_file(config_file, G_FILE_MONITOR_WATCH_MOVES, NULL, NULL);
+  if (self->config_monitor) {
+    g_signal_connect(self->config_monitor, "changed", G_CALLBACK(on_config_file_changed), self);
+    hyprmenu_config_set_reload_func(on_config_reloaded, self);
+  }
+  g_object_unref(config_file);
 }
 
 static void
@@ -796,6 +904,23 @@ hyprmenu_window_dispose(GObject *object)
     self->click_gesture = NULL;
   }
   
+  if (self->search_tick_id) {
+    gtk_widget_remove_tick_callback(self->search_entry, self->search_tick_id);
+    self->search_tick_id = 0;
+  }
+  
+  if (self->config_monitor) {
+    hyprmenu_config_set_reload_func(NULL, NULL);
+    g_signal_handlers_disconnect_by_data(self->config_monitor, self);
+    g_file_monitor_cancel(self->config_monitor);
+    g_clear_object(&self->config_monitor);
+  }
+  
+  if (self->config_reload_id) {
+    g_source_remove(self->config_reload_id);
+    self->config_reload_id = 0;
+  }
+  
   // Properly unparent child widgets
   if (self->main_box) {
     GtkWidget *child = gtk_widget_get_first_child(self->main_box);
@@ -841,10 +966,19 @@ hyprmenu_window_new (GtkApplication *app)
                        NULL);
 }
 
+void
+hyprmenu_window_prepare (HyprMenuWindow *self)
+{
+  g_return_if_fail (HYPRMENU_IS_WINDOW (self));
+  
+  // Only reload the applications when they changed since the last show
+  hyprmenu_app_grid_ensure_fresh (HYPRMENU_APP_GRID (self->app_grid));
+}
+
 void
 hyprmenu_window_show (HyprMenuWindow *self)
 {
-  hyprmenu_app_grid_refresh (HYPRMENU_APP_GRID (self->app_grid));
+  hyprmenu_window_prepare (self);
   gtk_window_present (GTK_WINDOW (self));
   
   // Directly focus the search entry when showing the window
@@ -854,6 +988,46 @@ hyprmenu_window_show (HyprMenuWindow *self)
   }
 }
 
+void
+hyprmenu_window_set_resident (HyprMenuWindow *self, gboolean resident)
+{
+  g_return_if_fail (HYPRMENU_IS_WINDOW (self));
+  
+  self->resident = resident;
+  
+  /* gtk_window_close() from the app views then hides the layer surface */
+  gtk_window_set_hide_on_close (GTK_WINDOW (self), resident);
+}
+
+void
+hyprmenu_window_dismiss (HyprMenuWindow *self)
+{
+  g_return_if_fail (HYPRMENU_IS_WINDOW (self));
+  
+  if (self->resident) {
+    gtk_widget_set_visible (GTK_WIDGET (self), FALSE);
+    return;
+  }
+  
+  GtkApplication *app = gtk_window_get_application (GTK_WINDOW (self));
+  gtk_window_close (GTK_WINDOW (self));
+  if (app) {
+    g_application_quit (G_APPLICATION (app));
+  }
+}
+
+void
+hyprmenu_window_toggle (HyprMenuWindow *self)
+{
+  g_return_if_fail (HYPRMENU_IS_WINDOW (self));
+  
+  if (gtk_widget_get_visible (GTK_WIDGET (self))) {
+    hyprmenu_window_dismiss (self);
+  } else {
+    hyprmenu_window_show (self);
+  }
+}
+
 static void
 execute_system_action(HyprMenuWindow *self, 
                      const char *command,
@@ -864,10 +1038,7 @@ execute_system_action(HyprMenuWindow *self,
   GError *error = NULL;
   
   // First close the menu
-  GtkApplication *app = gtk_window_get_application(GTK_WINDOW(self));
-  if (app) {
-    g_application_quit(G_APPLICATION(app));
-  }
+  hyprmenu_window_dismiss(self);
 
   // Execute the command asynchronously
   if (!g_spawn_command_line_async(command, &error)) {
@@ -21,9 +21,20 @@ typedef struct _HyprMenuWindow {
   
   GtkEventController *key_controller;
   GtkGestureClick *click_gesture;
+  
+  guint search_tick_id;  // Pending search, run on the next frame
+  
+  GFileMonitor *config_monitor;  // Watches the config file for edits
+  guint config_reload_id;        // Pending reload after an edit
+  
+  gboolean resident;  // Hide instead of quitting when dismissed (daemon mode)
 } HyprMenuWindow;
 
 HyprMenuWindow *hyprmenu_window_new (GtkApplication *app);
 void hyprmenu_window_show (HyprMenuWindow *self);
+void hyprmenu_window_prepare (HyprMenuWindow *self);
+void hyprmenu_window_toggle (HyprMenuWindow *self);
+void hyprmenu_window_dismiss (HyprMenuWindow *self);
+void hyprmenu_window_set_resident (HyprMenuWindow *self, gboolean resident);
 
 G_END_DECLS 
\ No newline at end of file